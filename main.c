@@ -1,4 +1,4 @@
-// Generates a V1 QR Code
+// Generates a V1-V4 QR Code
 // Dan Jackson, 2020
 
 #ifdef _WIN32
@@ -6,6 +6,19 @@
 #include <windows.h>
 #include <io.h>
 #include <fcntl.h>
+#else
+#define _POSIX_C_SOURCE 200112L
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define BATCH_THREADS
+#define SERVE_UNIX
 #endif
 
 //#include <inttypes.h>
@@ -13,61 +26,1089 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdarg.h>
 
 #include "qrtiny.h"
+#include "qrtinyrecords.h"
 
 typedef enum {
     OUTPUT_TEXT_MEDIUM,
+    OUTPUT_PBM,
+    OUTPUT_PGM,
+    OUTPUT_PNG,
+    OUTPUT_SVG,
+    OUTPUT_RECORDS,
+    OUTPUT_MODES,       // Number of output modes
 } output_mode_t;
 
-void OutputQrTinyTextMedium(uint8_t *buffer, uint16_t formatInfo, FILE* fp, int quiet, bool invert)
+// Reusable output buffer: each image is built in memory and written with a single fwrite()
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+} output_buffer_t;
+
+// Reserve space for the given number of bytes, returning the write position
+static uint8_t *OutputReserve(output_buffer_t *out, size_t size)
+{
+    if (out->length + size > out->capacity)
+    {
+        size_t capacity = out->capacity ? out->capacity : 4096;
+        while (capacity < out->length + size) capacity *= 2;
+        uint8_t *data = (uint8_t *)realloc(out->data, capacity);
+        if (data == NULL) { fprintf(stderr, "ERROR: Out of memory.\n"); exit(-1); }
+        out->data = data;
+        out->capacity = capacity;
+    }
+    return out->data + out->length;
+}
+
+static void OutputAppend(output_buffer_t *out, const void *data, size_t size)
 {
+    memcpy(OutputReserve(out, size), data, size);
+    out->length += size;
+}
+
+static void OutputPrintf(output_buffer_t *out, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int size = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (size < 0) return;
+    char *p = (char *)OutputReserve(out, (size_t)size + 1);
+    va_start(args, format);
+    vsnprintf(p, (size_t)size + 1, format, args);
+    va_end(args);
+    out->length += (size_t)size;
+}
+
+// Module from the rendered rows, light outside of the symbol
+static int ModuleAt(const qrtiny_row_t rows[QRTINY_DIMENSION], int x, int y)
+{
+    if (x < 0 || y < 0 || x >= QRTINY_DIMENSION || y >= QRTINY_DIMENSION) return 0;
+    return (rows[y] >> x) & 1;
+}
+
+void OutputQrTinyTextMedium(const qrtiny_row_t rows[QRTINY_DIMENSION], output_buffer_t *out, int quiet, bool invert)
+{
+    static const char *glyphs[4] = {
+        " ",    // '\u{0020}' space
+        "▀",    // '\u{2580}' upper half block
+        "▄",    // '\u{2584}' lower half block
+        "█",    // '\u{2588}' block
+    };
+    int width = QRTINY_DIMENSION + 2 * quiet;
     for (int y = -quiet; y < QRTINY_DIMENSION + quiet; y += 2)
     {
+        char *p = (char *)OutputReserve(out, (size_t)width * 3 + 1);
         for (int x = -quiet; x < QRTINY_DIMENSION + quiet; x++)
         {
-            int bitU = QrTinyModuleGet(buffer, formatInfo, x, y) & 1;
-            int bitL = (y + 1 < QRTINY_DIMENSION + quiet) ? (QrTinyModuleGet(buffer, formatInfo, x, y + 1) & 1) : (invert ? 1 : 0);
+            int bitU = ModuleAt(rows, x, y);
+            int bitL = (y + 1 < QRTINY_DIMENSION + quiet) ? ModuleAt(rows, x, y + 1) : (invert ? 1 : 0);
             int value = ((bitL ? 2 : 0) + (bitU ? 1 : 0)) ^ (invert ? 0x3 : 0x0);
-            switch (value)
+            for (const char *glyph = glyphs[value]; *glyph; glyph++) *p++ = *glyph;
+        }
+        *p++ = '\n';
+        out->length = (size_t)((uint8_t *)p - out->data);
+    }
+}
+
+// Netpbm bitmap (P4, 1=black) or graymap (P5, 0=black), drawn directly by the blitter
+void OutputQrTinyNetpbm(const uint8_t *buffer, uint16_t formatInfo, output_buffer_t *out, int quiet, bool invert, int scale, bool graymap)
+{
+    int size = (QRTINY_DIMENSION + 2 * quiet) * scale;
+    size_t rowBytes = graymap ? (size_t)size : (size_t)(size + 7) / 8;
+    OutputPrintf(out, graymap ? "P5\n%d %d\n255\n" : "P4\n%d %d\n", size, size);
+    uint8_t *pixels = OutputReserve(out, rowBytes * (size_t)size);
+    memset(pixels, 0, rowBytes * (size_t)size);     // Bitmap rows are padded with zero bits
+    QrTinyBlit(buffer, formatInfo, pixels, rowBytes, graymap ? QRTINY_PIXEL_8BPP : QRTINY_PIXEL_1BPP_MSB, scale, quiet, invert);
+    out->length += rowBytes * (size_t)size;
+}
+
+// --- PNG (1-bit grayscale, deflate stored blocks, no compression library required) ---
+// CRC-32 of each byte value (reflected polynomial 0xedb88320), constant so that it can be shared by the worker threads
+static const uint32_t crc32Table[256] = {
+    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
+    0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
+    0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9, 0xfa0f3d63, 0x8d080df5,
+    0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172, 0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
+    0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423, 0xcfba9599, 0xb8bda50f,
+    0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924, 0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d,
+    0x76dc4190, 0x01db7106, 0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
+    0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e, 0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457,
+    0x65b0d9c6, 0x12b7e950, 0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb,
+    0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0, 0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9,
+    0x5005713c, 0x270241aa, 0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad,
+    0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a, 0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683,
+    0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb, 0x196c3671, 0x6e6b06e7,
+    0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc, 0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
+    0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55, 0x316e8eef, 0x4669be79,
+    0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236, 0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f,
+    0xc5ba3bbe, 0xb2bd0b28, 0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
+    0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38, 0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21,
+    0x86d3d2d4, 0xf1d4e242, 0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45,
+    0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2, 0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db,
+    0xaed16a4a, 0xd9d65adc, 0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
+    0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
+};
+
+static uint32_t Crc32(uint32_t crc, const uint8_t *data, size_t length)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) crc = crc32Table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void OutputBigEndian32(output_buffer_t *out, uint32_t value)
+{
+    uint8_t bytes[4] = { (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value };
+    OutputAppend(out, bytes, sizeof(bytes));
+}
+
+// Deflate stored-block stream: inserts a block header every 65535 bytes, and tracks the zlib Adler-32 checksum
+#define DEFLATE_STORED_MAX 0xffff
+typedef struct {
+    output_buffer_t *out;
+    size_t remaining;       // Bytes of data still to write in total
+    size_t blockRemaining;  // Bytes still to write in the current block
+    uint32_t a, b;          // Adler-32
+} deflate_stored_t;
+
+static void DeflateStoredAppend(deflate_stored_t *deflate, const uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        if (deflate->blockRemaining == 0)
+        {
+            size_t blockLength = deflate->remaining > DEFLATE_STORED_MAX ? DEFLATE_STORED_MAX : deflate->remaining;
+            uint8_t header[5] = { (uint8_t)(blockLength == deflate->remaining ? 0x01 : 0x00), (uint8_t)blockLength, (uint8_t)(blockLength >> 8), (uint8_t)~blockLength, (uint8_t)(~blockLength >> 8) };
+            OutputAppend(deflate->out, header, sizeof(header));
+            deflate->blockRemaining = blockLength;
+        }
+        size_t count = length < deflate->blockRemaining ? length : deflate->blockRemaining;
+        OutputAppend(deflate->out, data, count);
+        for (size_t i = 0; i < count; i++)
+        {
+            deflate->a = (deflate->a + data[i]) % 65521;
+            deflate->b = (deflate->b + deflate->a) % 65521;
+        }
+        deflate->remaining -= count;
+        deflate->blockRemaining -= count;
+        data += count;
+        length -= count;
+    }
+}
+
+void OutputQrTinyPng(const qrtiny_row_t rows[QRTINY_DIMENSION], output_buffer_t *out, int quiet, bool invert, int scale)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    uint32_t size = (uint32_t)((QRTINY_DIMENSION + 2 * quiet) * scale);
+    size_t rowBytes = 1 + (size + 7) / 8;   // Filter type and 1-bit pixels
+    size_t rawLength = rowBytes * size;
+    size_t blocks = (rawLength + DEFLATE_STORED_MAX - 1) / DEFLATE_STORED_MAX;
+
+    OutputAppend(out, signature, sizeof(signature));
+
+    // IHDR: width, height, bit depth 1, color type 0 (grayscale), compression 0, filter 0, interlace 0
+    size_t chunk = out->length;
+    OutputBigEndian32(out, 13);
+    OutputAppend(out, "IHDR", 4);
+    OutputBigEndian32(out, size);
+    OutputBigEndian32(out, size);
+    OutputAppend(out, "\x01\x00\x00\x00\x00", 5);
+    OutputBigEndian32(out, Crc32(0, out->data + chunk + 4, out->length - chunk - 4));
+
+    // IDAT: zlib header, stored deflate blocks of the scanlines, Adler-32
+    chunk = out->length;
+    OutputBigEndian32(out, (uint32_t)(2 + 5 * blocks + rawLength + 4));
+    OutputAppend(out, "IDAT", 4);
+    OutputAppend(out, "\x78\x01", 2);
+    deflate_stored_t deflate = { out, rawLength, 0, 1, 0 };
+    uint8_t *line = (uint8_t *)malloc(rowBytes);
+    if (line == NULL) { fprintf(stderr, "ERROR: Out of memory.\n"); exit(-1); }
+    for (int y = -quiet; y < QRTINY_DIMENSION + quiet; y++)
+    {
+        // Build one scanline (bit set is white), then repeat it for the scale
+        memset(line, 0, rowBytes);
+        for (int x = -quiet; x < QRTINY_DIMENSION + quiet; x++)
+        {
+            int light = !ModuleAt(rows, x, y) ^ (invert ? 1 : 0);
+            int start = (x + quiet) * scale;
+            if (light) for (int i = start; i < start + scale; i++) line[1 + (i >> 3)] |= 0x80 >> (i & 7);
+        }
+        for (int i = 0; i < scale; i++) DeflateStoredAppend(&deflate, line, rowBytes);
+    }
+    free(line);
+    OutputBigEndian32(out, (deflate.b << 16) | deflate.a);
+    OutputBigEndian32(out, Crc32(0, out->data + chunk + 4, out->length - chunk - 4));
+
+    // IEND
+    OutputBigEndian32(out, 0);
+    OutputAppend(out, "IEND", 4);
+    OutputBigEndian32(out, Crc32(0, (const uint8_t *)"IEND", 4));
+}
+
+// SVG: one path, with each horizontal run of dark modules merged into a single rectangle segment
+void OutputQrTinySvg(const qrtiny_row_t rows[QRTINY_DIMENSION], output_buffer_t *out, int quiet, bool invert, int scale)
+{
+    int size = QRTINY_DIMENSION + 2 * quiet;
+    OutputPrintf(out, "<?xml version=\"1.0\"?>\n");
+    OutputPrintf(out, "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 %d %d\" width=\"%d\" height=\"%d\" shape-rendering=\"crispEdges\">\n", size, size, size * scale, size * scale);
+    OutputPrintf(out, "<rect width=\"%d\" height=\"%d\" fill=\"%s\"/>\n", size, size, invert ? "#000" : "#fff");
+    OutputPrintf(out, "<path fill=\"%s\" d=\"", invert ? "#fff" : "#000");
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        for (int x = 0; x < QRTINY_DIMENSION; )
+        {
+            if (!ModuleAt(rows, x, y)) { x++; continue; }
+            int start = x;
+            while (ModuleAt(rows, x, y)) x++;
+            OutputPrintf(out, "M%d,%dh%dv1h-%dz", start + quiet, y + quiet, x - start, x - start);
+        }
+    }
+    OutputPrintf(out, "\"/>\n</svg>\n");
+}
+
+
+#ifdef QRTINY_STATS
+// Statistics of the finished batch worker threads
+static qrtiny_stats_t workerStats;
+
+// Dump the per-phase statistics of all threads
+static void OutputStats(FILE *fp)
+{
+    qrtiny_stats_t stats;
+    QrTinyStatsGet(&stats);
+    QrTinyStatsAdd(&stats, &workerStats);
+    fprintf(fp, "%-9s %10s %14s %10s %10s  %s\n", "phase", "calls", "total-" QRTINY_STATS_CLOCK_UNITS, "mean", "max", "histogram (from: calls)");
+    for (int phase = 0; phase < QRTINY_STATS_PHASES; phase++)
+    {
+        const qrtiny_stats_phase_t *p = &stats.phases[phase];
+        if (p->calls == 0) continue;
+        fprintf(fp, "%-9s %10llu %14llu %10.1f %10llu ", QrTinyStatsPhaseName(phase), (unsigned long long)p->calls, (unsigned long long)p->total, (double)p->total / (double)p->calls, (unsigned long long)p->max);
+        for (int bucket = 0; bucket < QRTINY_STATS_BUCKETS; bucket++)
+        {
+            if (p->histogram[bucket]) fprintf(fp, " %llu:%llu", bucket ? 1ULL << bucket : 0ULL, (unsigned long long)p->histogram[bucket]);
+        }
+        fprintf(fp, "\n");
+    }
+}
+#endif
+
+// Code options, common to every value
+typedef struct {
+    output_mode_t outputMode;
+    int quiet;
+    bool invert;
+    int scale;
+    bool verify;
+    int ecl;            // -1 for automatic
+    int maskPattern;    // -1 for automatic
+} code_options_t;
+
+// Encode a value to the buffer, setting the error-correction level to the strongest that fits (unless one was specified), returning an error message (or NULL on success)
+static const char *EncodeCode(const char *value, size_t valueLength, int *ecl, uint8_t *buffer, size_t *payloadLength)
+{
+    static const int eccCodewords[4] = { QRTINY_ECC_BLOCK_CODEWORDS };
+    static const int eccBlocks[4] = { QRTINY_ECC_BLOCKS };
+
+    // Plan the segment modes, and the strongest error-correction level that fits (unless one was specified)
+    qrtiny_plan_t plan;
+    if (!QrTinyPlan(value, valueLength, &plan)) return "Could not generate QR Code (data too long).";
+    if (*ecl < 0) *ecl = plan.ecl;
+    if (plan.bits > (QRTINY_TOTAL_CAPACITY / 8 - (size_t)eccCodewords[*ecl] * (size_t)eccBlocks[*ecl]) * 8) return "Could not generate QR Code (data too long).";
+
+    // Encode the text into the buffer
+    *payloadLength = QrTinyPlanWrite(buffer, 0, value, &plan);
+    return NULL;
+}
+
+// Append the output of a generated buffer, at the format info given, for a value, returning an error message (or NULL on success)
+static const char *OutputSymbol(const code_options_t *options, const char *value, size_t valueLength, const uint8_t *buffer, uint16_t formatInfo, output_buffer_t *out)
+{
+    qrtiny_row_t rows[QRTINY_DIMENSION];
+    QrTinyRender(buffer, formatInfo, rows);
+
+    // Check the rendered symbol decodes back to the value
+    if (options->verify)
+    {
+        uint8_t decoded[QRTINY_BUFFER_SIZE];
+        uint16_t decodedFormatInfo;
+        char text[QRTINY_BUFFER_SIZE * 2];
+        if (QrTinyVerify(rows, decoded, &decodedFormatInfo) != 0 || QrTinyDecode(decoded, decodedFormatInfo, text, sizeof(text)) != (int)valueLength || memcmp(text, value, valueLength) != 0)
+        {
+            return "QR Code did not verify.";
+        }
+    }
+
+    switch (options->outputMode)
+    {
+        case OUTPUT_TEXT_MEDIUM: OutputQrTinyTextMedium(rows, out, options->quiet, options->invert); break;
+        case OUTPUT_PBM: OutputQrTinyNetpbm(buffer, formatInfo, out, options->quiet, options->invert, options->scale, false); break;
+        case OUTPUT_PGM: OutputQrTinyNetpbm(buffer, formatInfo, out, options->quiet, options->invert, options->scale, true); break;
+        case OUTPUT_PNG: OutputQrTinyPng(rows, out, options->quiet, options->invert, options->scale); break;
+        case OUTPUT_SVG: OutputQrTinySvg(rows, out, options->quiet, options->invert, options->scale); break;
+        case OUTPUT_RECORDS:
+            QrTinyRecordMake((qrtiny_record_t *)OutputReserve(out, sizeof(qrtiny_record_t)), buffer, formatInfo, value, valueLength);
+            out->length += sizeof(qrtiny_record_t);
+            break;
+        default: OutputPrintf(out, "<error>"); break;
+    }
+    return NULL;
+}
+
+// Append the output of a generated buffer for a value, returning an error message (or NULL on success)
+static const char *OutputGenerated(const code_options_t *options, const char *value, size_t valueLength, const uint8_t *buffer, int ecl, int maskPattern, output_buffer_t *out)
+{
+    // Choose the mask pattern with the lowest penalty, unless one was specified
+    uint16_t formatInfo = (maskPattern < 0) ? QrTinyChooseMask(buffer, ecl) : QrTinyFormatInfo(ecl, maskPattern);
+    return OutputSymbol(options, value, valueLength, buffer, formatInfo, out);
+}
+
+// Generate the code for a value and append its output, returning an error message (or NULL on success)
+static const char *OutputCode(const code_options_t *options, const char *value, size_t valueLength, int ecl, int maskPattern, output_buffer_t *out)
+{
+    // Create a buffer for holding the encoded payload and ECC calculations
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+    size_t payloadLength;
+    const char *error = EncodeCode(value, valueLength, &ecl, buffer, &payloadLength);
+    if (error != NULL) return error;
+
+    // Generate the QR Code bitmap (the error-correction codewords do not depend on the mask pattern)
+    if (!QrTinyGenerate(buffer, payloadLength, QrTinyFormatInfo(ecl, 0))) return "Could not generate QR Code (data too long).";
+    return OutputGenerated(options, value, valueLength, buffer, ecl, maskPattern, out);
+}
+
+// --- Batch mode: one value per line (or null-delimited), in chunks, output in input order ---
+#define BATCH_CHUNK_ITEMS 256           // Values per chunk of work
+#define BATCH_CHUNKS_PER_THREAD 4       // Chunks in flight per worker (the reorder window)
+
+// A value of a chunk, encoded then generated along with the others at its error-correction level
+typedef struct {
+    const char *value;
+    size_t valueLength;
+    int ecl;
+    int maskPattern;
+    const char *error;
+    size_t payloadLength;
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+} batch_item_t;
+
+typedef struct {
+    output_buffer_t text;                       // Values, each followed by a null
+    size_t offsets[BATCH_CHUNK_ITEMS + 1];      // Start of each value (and end of the last, after its null)
+    int count;
+    unsigned long firstLine;
+    batch_item_t items[BATCH_CHUNK_ITEMS];
+    output_buffer_t out;                        // Output of the chunk's codes, in order
+    output_buffer_t errors;                     // Error messages for the chunk's values, in order
+    int failures;
+    bool done;
+} batch_chunk_t;
+
+typedef struct {
+    FILE *fp;
+    uint8_t delimiter;
+    uint8_t buffer[65536];
+    size_t position;
+    size_t length;
+    unsigned long line;
+} batch_reader_t;
+
+// Read the next value to the end of the text, returning false at the end of the input
+static bool BatchReadValue(batch_reader_t *reader, output_buffer_t *text)
+{
+    size_t start = text->length;
+    bool any = false;
+    for (;;)
+    {
+        if (reader->position >= reader->length)
+        {
+            reader->position = 0;
+            reader->length = fread(reader->buffer, 1, sizeof(reader->buffer), reader->fp);
+            if (reader->length == 0) break;
+        }
+        any = true;
+        const uint8_t *p = reader->buffer + reader->position;
+        size_t available = reader->length - reader->position;
+        const uint8_t *end = (const uint8_t *)memchr(p, reader->delimiter, available);
+        size_t count = end ? (size_t)(end - p) : available;
+        OutputAppend(text, p, count);
+        reader->position += count;
+        if (end) { reader->position++; break; }
+    }
+    if (!any) return false;
+    // Remove the carriage return of a CRLF line ending
+    if (reader->delimiter == '\n' && text->length > start && text->data[text->length - 1] == '\r') text->length--;
+    OutputAppend(text, "", 1);
+    reader->line++;
+    return true;
+}
+
+// Read the next chunk of values, returning false at the end of the input
+static bool BatchReadChunk(batch_reader_t *reader, batch_chunk_t *chunk)
+{
+    chunk->text.length = 0;
+    chunk->count = 0;
+    chunk->firstLine = reader->line + 1;
+    while (chunk->count < BATCH_CHUNK_ITEMS)
+    {
+        chunk->offsets[chunk->count] = chunk->text.length;
+        if (!BatchReadValue(reader, &chunk->text)) break;
+        chunk->count++;
+    }
+    chunk->offsets[chunk->count] = chunk->text.length;
+    return chunk->count > 0;
+}
+
+// Per-value override "@<l|m|q|h><0-7> value" (either part may be omitted)
+static bool BatchParseOverride(const char *override, size_t length, int *ecl, int *maskPattern)
+{
+    size_t i = 0;
+    if (i < length)
+    {
+        switch (override[i])
+        {
+            case 'l': *ecl = QRTINY_ECL_LOW; i++; break;
+            case 'm': *ecl = QRTINY_ECL_MEDIUM; i++; break;
+            case 'q': *ecl = QRTINY_ECL_QUARTILE; i++; break;
+            case 'h': *ecl = QRTINY_ECL_HIGH; i++; break;
+        }
+    }
+    if (i < length && override[i] >= '0' && override[i] <= '7') *maskPattern = override[i++] - '0';
+    return i == length;
+}
+
+static void BatchProcess(const code_options_t *options, batch_chunk_t *chunk)
+{
+    chunk->out.length = 0;
+    chunk->errors.length = 0;
+    chunk->failures = 0;
+
+    // Encode each value (after any override)
+    for (int i = 0; i < chunk->count; i++)
+    {
+        batch_item_t *item = &chunk->items[i];
+        item->value = (const char *)chunk->text.data + chunk->offsets[i];
+        item->valueLength = chunk->offsets[i + 1] - chunk->offsets[i] - 1;
+        item->ecl = options->ecl;
+        item->maskPattern = options->maskPattern;
+        item->error = NULL;
+        if (item->valueLength > 0 && item->value[0] == '@')
+        {
+            const char *space = (const char *)memchr(item->value, ' ', item->valueLength);
+            if (space == NULL || !BatchParseOverride(item->value + 1, (size_t)(space - item->value - 1), &item->ecl, &item->maskPattern))
             {
-                case 0: fprintf(fp, " "); break; // '\u{0020}' space
-                case 1: fprintf(fp, "▀"); break; // '\u{2580}' upper half block
-                case 2: fprintf(fp, "▄"); break; // '\u{2584}' lower half block
-                case 3: fprintf(fp, "█"); break; // '\u{2588}' block
+                item->error = "Invalid override (expected: @<l|m|q|h><0-7> value).";
+                continue;
             }
+            item->valueLength -= (size_t)(space + 1 - item->value);
+            item->value = space + 1;
         }
-        fprintf(fp, "\n");
+        item->error = EncodeCode(item->value, item->valueLength, &item->ecl, item->buffer, &item->payloadLength);
+    }
+
+    // Generate the encoded values together, for each error-correction level
+    for (int ecl = 0; ecl < 4; ecl++)
+    {
+        uint8_t *buffers[BATCH_CHUNK_ITEMS];
+        size_t payloadLengths[BATCH_CHUNK_ITEMS];
+        size_t count = 0;
+        for (int i = 0; i < chunk->count; i++)
+        {
+            batch_item_t *item = &chunk->items[i];
+            if (item->error != NULL || item->ecl != ecl) continue;
+            buffers[count] = item->buffer;
+            payloadLengths[count] = item->payloadLength;
+            count++;
+        }
+        if (count > 0 && !QrTinyGenerateBatch(buffers, payloadLengths, count, QrTinyFormatInfo(ecl, 0)))
+        {
+            fprintf(stderr, "ERROR: Batch generation failed.\n");     // Not expected: each payload was checked to fit when encoded
+            exit(-1);
+        }
+    }
+
+    // Output each code in order
+    for (int i = 0; i < chunk->count; i++)
+    {
+        batch_item_t *item = &chunk->items[i];
+        const char *error = item->error;
+        if (error == NULL) error = OutputGenerated(options, item->value, item->valueLength, item->buffer, item->ecl, item->maskPattern, &chunk->out);
+        if (error != NULL)
+        {
+            OutputPrintf(&chunk->errors, "ERROR: Line %lu: %s\n", chunk->firstLine + (unsigned long)i, error);
+            chunk->failures++;
+        }
+    }
+}
+
+static void BatchWrite(batch_chunk_t *chunk, FILE *ofp, qrtiny_records_writer_t *recordsWriter)
+{
+    if (recordsWriter != NULL) QrTinyRecordsWriterAppend(recordsWriter, (const qrtiny_record_t *)chunk->out.data, chunk->out.length / sizeof(qrtiny_record_t));
+    else fwrite(chunk->out.data, 1, chunk->out.length, ofp);
+    if (chunk->errors.length) fwrite(chunk->errors.data, 1, chunk->errors.length, stderr);
+}
+
+#ifdef BATCH_THREADS
+// Each worker has a queue of chunks: it takes its own oldest chunk, or otherwise steals the newest chunk from the longest queue.
+// Chunks are coarse (hundreds of codes), so a single lock for the queues is not contended.
+typedef struct batch_s batch_t;
+
+typedef struct {
+    batch_t *batch;
+    int *queue;         // Ring of chunk indexes
+    int head;
+    int count;
+    pthread_t thread;
+#ifdef QRTINY_STATS
+    qrtiny_stats_t stats;   // The worker thread's statistics, when finished
+#endif
+} batch_worker_t;
+
+struct batch_s {
+    const code_options_t *options;
+    batch_chunk_t *chunks;
+    int chunkCount;
+    batch_worker_t *workers;
+    int workerCount;
+    pthread_mutex_t lock;
+    pthread_cond_t workAvailable;
+    pthread_cond_t chunkDone;
+    bool finished;
+};
+
+// Take the next chunk to work on (with the lock held), or -1 if there is none
+static int BatchTake(batch_t *batch, batch_worker_t *worker)
+{
+    if (worker->count > 0)
+    {
+        int index = worker->queue[worker->head];
+        worker->head = (worker->head + 1) % batch->chunkCount;
+        worker->count--;
+        return index;
+    }
+    batch_worker_t *victim = NULL;
+    for (int i = 0; i < batch->workerCount; i++)
+    {
+        if (batch->workers[i].count > (victim ? victim->count : 0)) victim = &batch->workers[i];
     }
+    if (victim == NULL) return -1;
+    victim->count--;
+    return victim->queue[(victim->head + victim->count) % batch->chunkCount];
 }
 
+static void *BatchWorker(void *arg)
+{
+    batch_worker_t *worker = (batch_worker_t *)arg;
+    batch_t *batch = worker->batch;
+    pthread_mutex_lock(&batch->lock);
+    for (;;)
+    {
+        int index = BatchTake(batch, worker);
+        if (index < 0)
+        {
+            if (batch->finished) break;
+            pthread_cond_wait(&batch->workAvailable, &batch->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&batch->lock);
+        BatchProcess(batch->options, &batch->chunks[index]);
+        pthread_mutex_lock(&batch->lock);
+        batch->chunks[index].done = true;
+        pthread_cond_signal(&batch->chunkDone);     // Only the main thread waits
+    }
+    pthread_mutex_unlock(&batch->lock);
+#ifdef QRTINY_STATS
+    QrTinyStatsGet(&worker->stats);
+#endif
+    return NULL;
+}
+#endif
+
+// Read, generate and write all of the values, returning the number of failures
+static unsigned long Batch(const code_options_t *options, FILE *ifp, FILE *ofp, qrtiny_records_writer_t *recordsWriter, uint8_t delimiter, int threads)
+{
+    static batch_reader_t reader;
+    reader.fp = ifp;
+    reader.delimiter = delimiter;
+    unsigned long failures = 0;
+
+#ifdef BATCH_THREADS
+    if (threads > 1)
+    {
+        batch_t batch;
+        memset(&batch, 0, sizeof(batch));
+        batch.options = options;
+        batch.workerCount = threads;
+        batch.chunkCount = threads * BATCH_CHUNKS_PER_THREAD;
+        batch.chunks = (batch_chunk_t *)calloc((size_t)batch.chunkCount, sizeof(batch_chunk_t));
+        batch.workers = (batch_worker_t *)calloc((size_t)batch.workerCount, sizeof(batch_worker_t));
+        if (batch.chunks == NULL || batch.workers == NULL) { fprintf(stderr, "ERROR: Out of memory.\n"); exit(-1); }
+        pthread_mutex_init(&batch.lock, NULL);
+        pthread_cond_init(&batch.workAvailable, NULL);
+        pthread_cond_init(&batch.chunkDone, NULL);
+        for (int i = 0; i < batch.workerCount; i++)
+        {
+            batch_worker_t *worker = &batch.workers[i];
+            worker->batch = &batch;
+            worker->queue = (int *)malloc((size_t)batch.chunkCount * sizeof(int));
+            if (worker->queue == NULL) { fprintf(stderr, "ERROR: Out of memory.\n"); exit(-1); }
+            if (pthread_create(&worker->thread, NULL, BatchWorker, worker) != 0) { fprintf(stderr, "ERROR: Unable to create thread.\n"); exit(-1); }
+        }
+
+        // Read ahead into the free chunks of the window (dealing them out to the workers' queues in turn), and write the oldest chunk when done
+        int head = 0;
+        int pending = 0;
+        unsigned long sequence = 0;
+        bool end = false;
+        for (;;)
+        {
+            while (!end && pending < batch.chunkCount)
+            {
+                int index = (head + pending) % batch.chunkCount;
+                if (!BatchReadChunk(&reader, &batch.chunks[index])) { end = true; break; }
+                pthread_mutex_lock(&batch.lock);
+                batch.chunks[index].done = false;
+                batch_worker_t *worker = &batch.workers[sequence++ % (unsigned long)batch.workerCount];
+                worker->queue[(worker->head + worker->count) % batch.chunkCount] = index;
+                worker->count++;
+                pthread_cond_broadcast(&batch.workAvailable);
+                pthread_mutex_unlock(&batch.lock);
+                pending++;
+            }
+            if (pending == 0) break;
+
+            pthread_mutex_lock(&batch.lock);
+            while (!batch.chunks[head].done) pthread_cond_wait(&batch.chunkDone, &batch.lock);
+            pthread_mutex_unlock(&batch.lock);
+            BatchWrite(&batch.chunks[head], ofp, recordsWriter);
+            failures += (unsigned long)batch.chunks[head].failures;
+            head = (head + 1) % batch.chunkCount;
+            pending--;
+        }
+
+        pthread_mutex_lock(&batch.lock);
+        batch.finished = true;
+        pthread_cond_broadcast(&batch.workAvailable);
+        pthread_mutex_unlock(&batch.lock);
+        for (int i = 0; i < batch.workerCount; i++)
+        {
+            pthread_join(batch.workers[i].thread, NULL);
+#ifdef QRTINY_STATS
+            QrTinyStatsAdd(&workerStats, &batch.workers[i].stats);
+#endif
+            free(batch.workers[i].queue);
+        }
+        for (int i = 0; i < batch.chunkCount; i++)
+        {
+            free(batch.chunks[i].text.data);
+            free(batch.chunks[i].out.data);
+            free(batch.chunks[i].errors.data);
+        }
+        pthread_cond_destroy(&batch.chunkDone);
+        pthread_cond_destroy(&batch.workAvailable);
+        pthread_mutex_destroy(&batch.lock);
+        free(batch.workers);
+        free(batch.chunks);
+        return failures;
+    }
+#else
+    (void)threads;
+#endif
+
+    // Single-threaded
+    static batch_chunk_t chunk;
+    while (BatchReadChunk(&reader, &chunk))
+    {
+        BatchProcess(options, &chunk);
+        BatchWrite(&chunk, ofp, recordsWriter);
+        failures += (unsigned long)chunk.failures;
+    }
+    free(chunk.text.data);
+    free(chunk.out.data);
+    free(chunk.errors.data);
+    return failures;
+}
+
+#ifdef SERVE_UNIX
+// --- Server mode: length-prefixed requests on a Unix domain socket, with an LRU cache of generated codes ---
+// Request:  u32 length (little-endian) of the rest: u8 output format (0=medium text, 1=pbm, 2=pgm, 3=png, 4=svg, 5=record),
+//           u8 error-correction level (QRTINY_ECL_*, or 0xff for automatic), u8 mask pattern (0-7, or 0xff for automatic), payload.
+// Response: u32 length (little-endian) of the rest: u8 status (0=ok, 1=error), then the output (or an error message).
+#define SERVE_REQUEST_MAX 4096
+#define SERVE_AUTOMATIC 0xff
+#define SERVE_STATUS_OK 0
+#define SERVE_STATUS_ERROR 1
+#define SERVE_IDLE_TIMEOUT 5                // Seconds a connection may wait on the client (reading or writing) before it is closed
+#define SERVE_ACCEPT_BACKOFF_MS 100         // Wait before accepting again when out of file descriptors or memory
+
+// Cache entry, keyed by the payload and the requested error-correction level and mask pattern, holding the generated codewords
+// and format info, and the output in each format requested so far
+typedef struct serve_entry_s serve_entry_t;
+struct serve_entry_s {
+    serve_entry_t *next;                    // Hash chain
+    serve_entry_t *newer, *older;           // Recency list
+    uint32_t hash;
+    uint8_t ecl, maskPattern;
+    size_t valueLength;
+    char *value;
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+    uint16_t formatInfo;
+    output_buffer_t outputs[OUTPUT_MODES];  // Empty (NULL data) until generated
+};
+
+typedef struct {
+    pthread_mutex_t lock;
+    serve_entry_t **table;
+    size_t tableSize;                       // Power of two
+    serve_entry_t *newest, *oldest;
+    size_t count, capacity;
+} serve_cache_t;
+
+typedef struct {
+    const code_options_t *options;
+    serve_cache_t *cache;
+    int listener;
+} serve_t;
+
+static uint32_t ServeHash(const char *value, size_t valueLength, uint8_t ecl, uint8_t maskPattern)
+{
+    return QrTinyRecordHash(value, valueLength) ^ (((uint32_t)ecl << 8 | maskPattern) * 0x9e3779b1);
+}
+
+// Find an entry (with the lock held)
+static serve_entry_t *ServeCacheFind(serve_cache_t *cache, uint32_t hash, const char *value, size_t valueLength, uint8_t ecl, uint8_t maskPattern)
+{
+    for (serve_entry_t *entry = cache->table[hash & (cache->tableSize - 1)]; entry != NULL; entry = entry->next)
+    {
+        if (entry->hash == hash && entry->ecl == ecl && entry->maskPattern == maskPattern && entry->valueLength == valueLength && !memcmp(entry->value, value, valueLength)) return entry;
+    }
+    return NULL;
+}
+
+static void ServeCacheUnlink(serve_cache_t *cache, serve_entry_t *entry)
+{
+    if (entry->newer) entry->newer->older = entry->older; else cache->newest = entry->older;
+    if (entry->older) entry->older->newer = entry->newer; else cache->oldest = entry->newer;
+}
+
+// Make an entry the most recently used (with the lock held)
+static void ServeCacheTouch(serve_cache_t *cache, serve_entry_t *entry)
+{
+    if (cache->newest == entry) return;
+    ServeCacheUnlink(cache, entry);
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    cache->newest->newer = entry;
+    cache->newest = entry;
+}
+
+// Add a new entry (with the lock held), evicting the least recently used beyond the capacity
+static void ServeCacheInsert(serve_cache_t *cache, serve_entry_t *entry)
+{
+    serve_entry_t **bucket = &cache->table[entry->hash & (cache->tableSize - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    if (cache->newest) cache->newest->newer = entry; else cache->oldest = entry;
+    cache->newest = entry;
+    if (++cache->count <= cache->capacity) return;
+
+    serve_entry_t *evict = cache->oldest;
+    ServeCacheUnlink(cache, evict);
+    for (bucket = &cache->table[evict->hash & (cache->tableSize - 1)]; *bucket != evict; bucket = &(*bucket)->next) { }
+    *bucket = evict->next;
+    cache->count--;
+    for (int i = 0; i < OUTPUT_MODES; i++) free(evict->outputs[i].data);
+    free(evict->value);
+    free(evict);
+}
+
+static bool ServeRead(int fd, void *data, size_t size)
+{
+    for (size_t done = 0; done < size; )
+    {
+        ssize_t count = read(fd, (uint8_t *)data + done, size - done);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;       // Closed, failed, or timed out (SO_RCVTIMEO)
+        done += (size_t)count;
+    }
+    return true;
+}
+
+static bool ServeWrite(int fd, const void *data, size_t size)
+{
+    for (size_t done = 0; done < size; )
+    {
+        ssize_t count = write(fd, (const uint8_t *)data + done, size - done);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;       // Failed, or timed out (SO_SNDTIMEO)
+        done += (size_t)count;
+    }
+    return true;
+}
+
+// Begin a response: the length (completed by ServeRespondEnd()) and status
+static void ServeRespondBegin(output_buffer_t *response, uint8_t status)
+{
+    response->length = 0;
+    uint8_t *header = OutputReserve(response, 5);
+    header[4] = status;
+    response->length = 5;
+}
+
+static void ServeRespondEnd(output_buffer_t *response)
+{
+    uint32_t length = (uint32_t)(response->length - 4);
+    for (int i = 0; i < 4; i++) response->data[i] = (uint8_t)(length >> (8 * i));
+}
+
+// Respond to one request (with the output from the cache where possible)
+static void ServeRequest(serve_t *serve, const uint8_t *request, size_t requestLength, output_buffer_t *response)
+{
+    if (requestLength < 3 || request[0] >= OUTPUT_MODES || (request[1] > QRTINY_ECL_QUARTILE && request[1] != SERVE_AUTOMATIC) || (request[2] > 7 && request[2] != SERVE_AUTOMATIC))
+    {
+        ServeRespondBegin(response, SERVE_STATUS_ERROR);
+        OutputPrintf(response, "Invalid request.");
+        ServeRespondEnd(response);
+        return;
+    }
+    output_mode_t outputMode = (output_mode_t)request[0];
+    uint8_t ecl = request[1], maskPattern = request[2];
+    const char *value = (const char *)request + 3;
+    size_t valueLength = requestLength - 3;
+    uint32_t hash = ServeHash(value, valueLength, ecl, maskPattern);
+    serve_cache_t *cache = serve->cache;
+
+    // Cached output, or the cached codewords to output in another format
+    bool cached = false;
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+    uint16_t formatInfo = 0;
+    pthread_mutex_lock(&cache->lock);
+    serve_entry_t *entry = ServeCacheFind(cache, hash, value, valueLength, ecl, maskPattern);
+    if (entry != NULL)
+    {
+        ServeCacheTouch(cache, entry);
+        const output_buffer_t *output = &entry->outputs[outputMode];
+        if (output->data != NULL)
+        {
+            ServeRespondBegin(response, SERVE_STATUS_OK);
+            OutputAppend(response, output->data, output->length);
+            pthread_mutex_unlock(&cache->lock);
+            ServeRespondEnd(response);
+            return;
+        }
+        memcpy(buffer, entry->buffer, sizeof(buffer));
+        formatInfo = entry->formatInfo;
+        cached = true;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    // Generate (unless cached) and output, without the lock held
+    code_options_t options = *serve->options;
+    options.outputMode = outputMode;
+    const char *error = NULL;
+    if (!cached)
+    {
+        int codeEcl = (ecl == SERVE_AUTOMATIC) ? -1 : ecl;
+        size_t payloadLength;
+        error = EncodeCode(value, valueLength, &codeEcl, buffer, &payloadLength);
+        if (error == NULL && !QrTinyGenerate(buffer, payloadLength, QrTinyFormatInfo(codeEcl, 0))) error = "Could not generate QR Code (data too long).";
+        if (error == NULL) formatInfo = (maskPattern == SERVE_AUTOMATIC) ? QrTinyChooseMask(buffer, codeEcl) : QrTinyFormatInfo(codeEcl, maskPattern);
+    }
+    ServeRespondBegin(response, SERVE_STATUS_OK);
+    if (error == NULL) error = OutputSymbol(&options, value, valueLength, buffer, formatInfo, response);
+    if (error != NULL)
+    {
+        ServeRespondBegin(response, SERVE_STATUS_ERROR);
+        OutputPrintf(response, "%s", error);
+        ServeRespondEnd(response);
+        return;
+    }
+    ServeRespondEnd(response);
+
+    // Cache the codewords and output (unless another thread got there first)
+    output_buffer_t output = { NULL, 0, 0 };
+    OutputAppend(&output, response->data + 5, response->length - 5);
+    pthread_mutex_lock(&cache->lock);
+    entry = ServeCacheFind(cache, hash, value, valueLength, ecl, maskPattern);
+    if (entry == NULL)
+    {
+        entry = (serve_entry_t *)calloc(1, sizeof(serve_entry_t));
+        char *entryValue = (char *)malloc(valueLength + 1);
+        if (entry == NULL || entryValue == NULL) { fprintf(stderr, "ERROR: Out of memory.\n"); exit(-1); }
+        memcpy(entryValue, value, valueLength);
+        entry->hash = hash;
+        entry->ecl = ecl;
+        entry->maskPattern = maskPattern;
+        entry->valueLength = valueLength;
+        entry->value = entryValue;
+        memcpy(entry->buffer, buffer, sizeof(buffer));
+        entry->formatInfo = formatInfo;
+        ServeCacheInsert(cache, entry);
+    }
+    if (entry->outputs[outputMode].data == NULL) entry->outputs[outputMode] = output;
+    else free(output.data);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+// Accept a connection, retrying after interruptions and aborted connections, and backing off while out of resources
+static int ServeAccept(int listener)
+{
+    for (;;)
+    {
+        int fd = accept(listener, NULL, NULL);
+        if (fd >= 0)
+        {
+            // Idle or slow clients are disconnected rather than holding the worker indefinitely
+            struct timeval timeout = { SERVE_IDLE_TIMEOUT, 0 };
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            return fd;
+        }
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+        {
+            struct timespec backoff = { 0, SERVE_ACCEPT_BACKOFF_MS * 1000000L };
+            nanosleep(&backoff, NULL);
+            continue;
+        }
+        return -1;
+    }
+}
+
+// Each worker accepts a connection and serves its requests until it closes (or is idle for too long)
+static void *ServeWorker(void *arg)
+{
+    serve_t *serve = (serve_t *)arg;
+    static const char *const invalid = "Request too long.";
+    uint8_t *request = (uint8_t *)malloc(SERVE_REQUEST_MAX);
+    output_buffer_t response = { NULL, 0, 0 };
+    if (request == NULL) { fprintf(stderr, "ERROR: Out of memory.\n"); exit(-1); }
+    for (;;)
+    {
+        int fd = ServeAccept(serve->listener);
+        if (fd < 0) { perror("ERROR: Unable to accept connection"); exit(-1); }
+        uint8_t header[4];
+        while (ServeRead(fd, header, sizeof(header)))
+        {
+            uint32_t length = (uint32_t)header[0] | ((uint32_t)header[1] << 8) | ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 24);
+            if (length > SERVE_REQUEST_MAX)
+            {
+                ServeRespondBegin(&response, SERVE_STATUS_ERROR);
+                OutputAppend(&response, invalid, strlen(invalid));
+                ServeRespondEnd(&response);
+                ServeWrite(fd, response.data, response.length);
+                break;
+            }
+            if (!ServeRead(fd, request, length)) break;
+            ServeRequest(serve, request, length, &response);
+            if (!ServeWrite(fd, response.data, response.length)) break;
+        }
+        close(fd);
+    }
+    return NULL;
+}
+
+// Serve requests on the socket until terminated
+static int Serve(const code_options_t *options, const char *path, int threads, size_t cacheEntries)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) { fprintf(stderr, "ERROR: Socket path too long: %s\n", path); return -1; }
+    strcpy(address.sun_path, path);
+
+    // Replace a stale socket (but not any other file)
+    struct stat st;
+    if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path);
+
+    static serve_t serve;
+    static serve_cache_t cache;
+    serve.options = options;
+    serve.cache = &cache;
+    serve.listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (serve.listener < 0 || bind(serve.listener, (const struct sockaddr *)&address, sizeof(address)) != 0 || listen(serve.listener, 64) != 0)
+    {
+        fprintf(stderr, "ERROR: Unable to listen on socket: %s\n", path);
+        return -1;
+    }
+    signal(SIGPIPE, SIG_IGN);   // Clients that disconnect early fail the write instead
+
+    pthread_mutex_init(&cache.lock, NULL);
+    cache.capacity = cacheEntries;
+    for (cache.tableSize = 64; cache.tableSize < cacheEntries; cache.tableSize <<= 1) { }
+    cache.table = (serve_entry_t **)calloc(cache.tableSize, sizeof(serve_entry_t *));
+    if (cache.table == NULL) { fprintf(stderr, "ERROR: Out of memory.\n"); return -1; }
+
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, ServeWorker, &serve) != 0) { fprintf(stderr, "ERROR: Unable to create thread.\n"); return -1; }
+        pthread_detach(thread);
+    }
+    for (;;) pause();
+}
+#endif
 
 int main(int argc, char *argv[])
 {
     FILE *ofp = stdout;
     const char *value = NULL;
     bool help = false;
-    bool invert = false;
-    int quiet = QRTINY_QUIET_STANDARD;
-    output_mode_t outputMode = OUTPUT_TEXT_MEDIUM;
-    uint16_t formatInfo = QRTINY_FORMATINFO_MASK_000_ECC_MEDIUM;
+    bool batch = false;
+    uint8_t delimiter = '\n';
+    int threads = 0;        // automatic
+    bool stats = false;
+    const char *serve = NULL;
+    long cacheEntries = 4096;
+    code_options_t options = { OUTPUT_TEXT_MEDIUM, QRTINY_QUIET_STANDARD, false, 1, false, -1, -1 };
     
     for (int i = 1; i < argc; i++)
     {
         if (!strcmp(argv[i], "--help")) { help = true; }
-        else if (!strcmp(argv[i], "--ecl:m")) { formatInfo = QRTINY_FORMATINFO_MASK_000_ECC_MEDIUM; }
-        else if (!strcmp(argv[i], "--ecl:l")) { formatInfo = QRTINY_FORMATINFO_MASK_000_ECC_LOW; }
-        else if (!strcmp(argv[i], "--ecl:h")) { formatInfo = QRTINY_FORMATINFO_MASK_000_ECC_HIGH; }
-        else if (!strcmp(argv[i], "--ecl:q")) { formatInfo = QRTINY_FORMATINFO_MASK_000_ECC_QUARTILE; }
-        else if (!strcmp(argv[i], "--quiet")) { quiet = atoi(argv[++i]); }
-        else if (!strcmp(argv[i], "--invert")) { invert = !invert; }
+        else if (!strcmp(argv[i], "--ecl:m")) { options.ecl = QRTINY_ECL_MEDIUM; }
+        else if (!strcmp(argv[i], "--ecl:l")) { options.ecl = QRTINY_ECL_LOW; }
+        else if (!strcmp(argv[i], "--ecl:h")) { options.ecl = QRTINY_ECL_HIGH; }
+        else if (!strcmp(argv[i], "--ecl:q")) { options.ecl = QRTINY_ECL_QUARTILE; }
+        else if (!strcmp(argv[i], "--ecl:auto")) { options.ecl = -1; }
+        else if (!strcmp(argv[i], "--mask:auto")) { options.maskPattern = -1; }
+        else if (!strncmp(argv[i], "--mask:", 7) && argv[i][7] >= '0' && argv[i][7] <= '7' && argv[i][8] == '\0') { options.maskPattern = argv[i][7] - '0'; }
+        else if (!strcmp(argv[i], "--quiet")) { options.quiet = atoi(argv[++i]); }
+        else if (!strcmp(argv[i], "--scale")) { options.scale = atoi(argv[++i]); }
+        else if (!strcmp(argv[i], "--invert")) { options.invert = !options.invert; }
+        else if (!strcmp(argv[i], "--verify")) { options.verify = true; }
+        else if (!strcmp(argv[i], "--batch")) { batch = true; }
+        else if (!strcmp(argv[i], "--null")) { delimiter = '\0'; }
+        else if (!strcmp(argv[i], "--threads")) { threads = atoi(argv[++i]); }
+        else if (!strcmp(argv[i], "--stats")) { stats = true; }
+        else if (!strcmp(argv[i], "--serve")) { serve = argv[++i]; }
+        else if (!strcmp(argv[i], "--cache")) { cacheEntries = atol(argv[++i]); }
         else if (!strcmp(argv[i], "--file"))
         {
             ofp = fopen(argv[++i], "wb");
             if (ofp == NULL) { fprintf(stderr, "ERROR: Unable to open output filename: %s\n", argv[i]); return -1; }
         }
-        else if (!strcmp(argv[i], "--output:medium")) { outputMode = OUTPUT_TEXT_MEDIUM; }
-        else if (argv[i][0] == '-')
+        else if (!strcmp(argv[i], "--output:medium")) { options.outputMode = OUTPUT_TEXT_MEDIUM; }
+        else if (!strcmp(argv[i], "--output:pbm")) { options.outputMode = OUTPUT_PBM; }
+        else if (!strcmp(argv[i], "--output:pgm")) { options.outputMode = OUTPUT_PGM; }
+        else if (!strcmp(argv[i], "--output:png")) { options.outputMode = OUTPUT_PNG; }
+        else if (!strcmp(argv[i], "--output:svg")) { options.outputMode = OUTPUT_SVG; }
+        else if (!strcmp(argv[i], "--output:records")) { options.outputMode = OUTPUT_RECORDS; }
+        else if (argv[i][0] == '-' && !(batch && !strcmp(argv[i], "-")))
         {
             fprintf(stderr, "ERROR: Unrecognized parameter: %s\n", argv[i]); 
             help = true;
@@ -85,46 +1126,122 @@ int main(int argc, char *argv[])
         }
     }
 
-    if (value == NULL)
+    if (value == NULL && !batch && serve == NULL)
     {
         fprintf(stderr, "ERROR: Value not specified.\n"); 
         help = true;
     }
 
+    if (options.scale < 1)
+    {
+        fprintf(stderr, "ERROR: Invalid scale.\n"); 
+        help = true;
+    }
+
+    if (threads < 0)
+    {
+        fprintf(stderr, "ERROR: Invalid number of threads.\n"); 
+        help = true;
+    }
+
+    if (cacheEntries < 1)
+    {
+        fprintf(stderr, "ERROR: Invalid cache size.\n");
+        help = true;
+    }
+
+#ifndef SERVE_UNIX
+    if (serve != NULL)
+    {
+        fprintf(stderr, "ERROR: Server mode not available on this platform.\n");
+        help = true;
+    }
+#endif
+
+#ifndef QRTINY_STATS
+    if (stats)
+    {
+        fprintf(stderr, "ERROR: Statistics not available (build with QRTINY_STATS defined).\n");
+        help = true;
+    }
+#endif
+
     if (help)
     {
-        fprintf(stderr, "Usage:  qrtiny [--ecl:<l|m|q|h>] [--invert] [--quiet 4] [--output:<medium>] [--file filename] <value>\n");
+        fprintf(stderr, "Usage:  qrtiny [--ecl:<auto|l|m|q|h>] [--mask:<auto|0-7>] [--invert] [--verify] [--stats] [--quiet 4] [--output:<medium|pbm|pgm|png|svg|records>] [--scale 1] [--file filename] <value>\n");
+        fprintf(stderr, "        qrtiny --batch [--null] [--threads 0] [options...] [<input-file>|-]\n");
+        fprintf(stderr, "        qrtiny --serve <unix-socket> [--threads 0] [--cache 4096] [options...]\n");
+        fprintf(stderr, "\n");
+        fprintf(stderr, "Batch mode reads one value per line (or null-delimited with --null), each optionally prefixed \"@<l|m|q|h><0-7> \" to override the options.\n");
+        fprintf(stderr, "Server mode answers length-prefixed requests for codes (see README.md), caching the most recently used.\n");
         fprintf(stderr, "\n");
         return -1;
     }
 
-    // Create a buffer for holding the encoded payload and ECC calculations
-    uint8_t buffer[QRTINY_BUFFER_SIZE];
+#ifdef SERVE_UNIX
+    if (serve != NULL)
+    {
+        if (threads == 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        return Serve(&options, serve, threads, (size_t)cacheEntries);
+    }
+#endif
 
-    // Encode the text into the buffer
-    size_t payloadLength = 0;
-    payloadLength += QrTinyWriteAlphanumeric(buffer, payloadLength, value); // QrTinyWriteNumeric(); QrTinyWrite8Bit();
+#ifdef _WIN32
+    if (options.outputMode == OUTPUT_TEXT_MEDIUM) SetConsoleOutputCP(CP_UTF8);
+    _setmode(_fileno(stdout), O_BINARY);
+    _setmode(_fileno(stdin), O_BINARY);
+#endif
 
-    // Generate the QR Code bitmap
-    bool result = QrTinyGenerate(buffer, payloadLength, formatInfo);
+    // Record files have a header (completed at the end, so the output must be seekable) and an index
+    qrtiny_records_writer_t recordsWriter;
+    if (options.outputMode == OUTPUT_RECORDS && !QrTinyRecordsWriterOpen(&recordsWriter, ofp, true))
+    {
+        fprintf(stderr, "ERROR: Unable to write records.\n");
+        return -1;
+    }
 
-    if (result)
+    int result = 0;
+    if (batch)
     {
-#ifdef _WIN32
-        if (outputMode == OUTPUT_TEXT_MEDIUM) SetConsoleOutputCP(CP_UTF8);
-        _setmode(_fileno(stdout), O_BINARY);
-#endif
-        switch (outputMode)
+        FILE *ifp = stdin;
+        if (value != NULL && strcmp(value, "-"))
         {
-            case OUTPUT_TEXT_MEDIUM: OutputQrTinyTextMedium(buffer, formatInfo, ofp, quiet, invert); break;
-            default: fprintf(ofp, "<error>"); break;
+            ifp = fopen(value, "rb");
+            if (ifp == NULL) { fprintf(stderr, "ERROR: Unable to open input filename: %s\n", value); return -1; }
         }
+#ifdef BATCH_THREADS
+        if (threads == 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        if (Batch(&options, ifp, ofp, options.outputMode == OUTPUT_RECORDS ? &recordsWriter : NULL, delimiter, threads) > 0) result = -1;
+        if (ifp != stdin) fclose(ifp);
     }
     else
     {
-        fprintf(stderr, "ERROR: Could not generate QR Code (data too long).\n");
+        output_buffer_t out = { NULL, 0, 0 };
+        const char *error = OutputCode(&options, value, strlen(value), options.ecl, options.maskPattern, &out);
+        if (error == NULL)
+        {
+            if (options.outputMode == OUTPUT_RECORDS) QrTinyRecordsWriterAppend(&recordsWriter, (const qrtiny_record_t *)out.data, 1);
+            else fwrite(out.data, 1, out.length, ofp);
+        }
+        else
+        {
+            fprintf(stderr, "ERROR: %s\n", error);
+            result = -1;
+        }
+        free(out.data);
     }
 
+    if (options.outputMode == OUTPUT_RECORDS && !QrTinyRecordsWriterClose(&recordsWriter))
+    {
+        fprintf(stderr, "ERROR: Unable to write records (the output must be a seekable file).\n");
+        result = -1;
+    }
+
+#ifdef QRTINY_STATS
+    if (stats) OutputStats(stderr);
+#endif
+
     if (ofp != stdout) fclose(ofp);
-    return 0;
+    return result;
 }
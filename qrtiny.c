@@ -1,29 +1,141 @@
-// QR Code V1 Generator
+// QR Code V1-V4 Generator
 // Dan Jackson, 2020
 
+#if defined(QRTINY_STATS) && !defined(QRTINY_STATS_CLOCK) && !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L     // clock_gettime()
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <string.h>
 
 #include "qrtiny.h"
 
+#ifdef QRTINY_STATS
+// --- Statistics ---
+#ifndef QRTINY_STATS_CLOCK
+#ifdef _WIN32
+#include <windows.h>
+static uint64_t QrTinyStatsClock(void)
+{
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+}
+#else
+#include <time.h>
+static uint64_t QrTinyStatsClock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+#endif
+#define QRTINY_STATS_CLOCK() QrTinyStatsClock()
+#endif
+
+// Per-thread, where the compiler supports it
+#if defined(_MSC_VER)
+static __declspec(thread) qrtiny_stats_t qrtinyStats;
+#elif defined(__GNUC__)
+static __thread qrtiny_stats_t qrtinyStats;
+#else
+static qrtiny_stats_t qrtinyStats;
+#endif
+
+static const char *const qrtinyStatsPhaseNames[QRTINY_STATS_PHASES] = { "plan", "write", "pad", "ecc", "render", "mask", "template", "verify" };
+
+static void QrTinyStatsRecord(int phase, uint64_t start)
+{
+    uint64_t elapsed = QRTINY_STATS_CLOCK() - start;
+    qrtiny_stats_phase_t *stats = &qrtinyStats.phases[phase];
+    int bucket = 0;
+    while (bucket < QRTINY_STATS_BUCKETS - 1 && (elapsed >> (bucket + 1)) != 0) bucket++;
+    stats->calls++;
+    stats->total += elapsed;
+    if (elapsed > stats->max) stats->max = elapsed;
+    stats->histogram[bucket]++;
+}
+
+void QrTinyStatsGet(qrtiny_stats_t *stats)
+{
+    *stats = qrtinyStats;
+}
+
+void QrTinyStatsReset(void)
+{
+    memset(&qrtinyStats, 0, sizeof(qrtinyStats));
+}
+
+void QrTinyStatsAdd(qrtiny_stats_t *total, const qrtiny_stats_t *stats)
+{
+    for (int phase = 0; phase < QRTINY_STATS_PHASES; phase++)
+    {
+        qrtiny_stats_phase_t *to = &total->phases[phase];
+        const qrtiny_stats_phase_t *from = &stats->phases[phase];
+        to->calls += from->calls;
+        to->total += from->total;
+        if (from->max > to->max) to->max = from->max;
+        for (int bucket = 0; bucket < QRTINY_STATS_BUCKETS; bucket++) to->histogram[bucket] += from->histogram[bucket];
+    }
+}
+
+const char *QrTinyStatsPhaseName(int phase)
+{
+    return (phase >= 0 && phase < QRTINY_STATS_PHASES) ? qrtinyStatsPhaseNames[phase] : NULL;
+}
+
+// Time a phase of a function (the start and end must be in the same scope)
+#define QRTINY_STATS_BEGIN(_phase) uint64_t qrtinyStatsStart##_phase = QRTINY_STATS_CLOCK()
+#define QRTINY_STATS_END(_phase) QrTinyStatsRecord(QRTINY_STATS_##_phase, qrtinyStatsStart##_phase)
+#else
+#define QRTINY_STATS_BEGIN(_phase) do { } while (0)
+#define QRTINY_STATS_END(_phase) do { } while (0)
+#endif
+
 #define QRTINY_MODULE_LIGHT 0
 #define QRTINY_MODULE_DARK 1
 #define QRTINY_MODULE_DATA -1
 
-// Write bits to buffer
-static size_t QrTinyBufferAppend(uint8_t *writeBuffer, size_t writePosition, uint32_t value, size_t bitCount)
+// Word-level bit writer: bits are accumulated and stored a whole byte at a time
+typedef struct
+{
+    uint8_t *buffer;        // Next byte to store
+    uint32_t accumulator;   // Pending bits (least-significant bits are the most recent)
+    int count;              // Number of pending bits
+} qrtiny_writer_t;
+
+static void QrTinyWriterStart(qrtiny_writer_t *writer, uint8_t *writeBuffer, size_t writePosition)
+{
+    writer->buffer = writeBuffer + (writePosition >> 3);
+    writer->count = (int)(writePosition & 0x07);
+    // Preserve any existing bits before the write position in the first byte
+    writer->accumulator = writer->count ? ((uint32_t)*writer->buffer >> (8 - writer->count)) : 0;
+}
+
+// Append up to 24 bits to the writer
+static void QrTinyWriterAppend(qrtiny_writer_t *writer, uint32_t value, int bitCount)
+{
+    writer->accumulator = (writer->accumulator << bitCount) | (value & ((1UL << bitCount) - 1));
+    writer->count += bitCount;
+    while (writer->count >= 8)
+    {
+        writer->count -= 8;
+        *writer->buffer++ = (uint8_t)(writer->accumulator >> writer->count);
+    }
+}
+
+static void QrTinyWriterEnd(qrtiny_writer_t *writer)
 {
-    for (size_t i = 0; i < bitCount; i++)
+    if (writer->count > 0)
     {
-        uint8_t *writeByte = writeBuffer + ((writePosition + i) >> 3);
-        int writeBit = 7 - ((writePosition + i) & 0x07);
-        int writeMask = (1 << writeBit);
-        int readMask = (1 << (bitCount - 1 - i));
-        *writeByte = (*writeByte & ~writeMask) | ((value & readMask) ? writeMask : 0);
+        // Preserve any existing bits after the write position in the last byte
+        uint8_t keep = (uint8_t)(0xff >> writer->count);
+        *writer->buffer = (uint8_t)((writer->accumulator << (8 - writer->count)) & ~keep) | (*writer->buffer & keep);
     }
-    return bitCount;
 }
 
 #define QRTINY_FORMATINFO_MASK 0x5412               // 0b0101010000010010
@@ -35,84 +147,121 @@ static size_t QrTinyBufferAppend(uint8_t *writeBuffer, size_t writePosition, uin
 #define QRTINY_SIZE_BCH 10                          // 10,5 BCH for format information
 #define QRTINY_SIZE_MODE_INDICATOR 4                // 4-bit mode indicator
 
-#define QRTINY_MODE_INDICATOR_NUMERIC      0x1      // 0b0001 Numeric (maximal groups of 3/2/1 digits encoded to 10/7/4-bit binary)
-#define QRTINY_MODE_INDICATOR_ALPHANUMERIC 0x2      // 0b0010 Alphanumeric ('0'-'9', 'A'-'Z', ' ', '$', '%', '*', '+', '-', '.', '/', ':') -> 0-44 index. Pairs combined (a*45+b) encoded as 11-bit; odd remainder encoded as 6-bit.
-#define QRTINY_MODE_INDICATOR_8_BIT        0x4      // 0b0100 8-bit byte
+#define QRTINY_MODE_INDICATOR_NUMERIC      QRTINY_MODE_NUMERIC          // 0b0001 Numeric (maximal groups of 3/2/1 digits encoded to 10/7/4-bit binary)
+#define QRTINY_MODE_INDICATOR_ALPHANUMERIC QRTINY_MODE_ALPHANUMERIC     // 0b0010 Alphanumeric ('0'-'9', 'A'-'Z', ' ', '$', '%', '*', '+', '-', '.', '/', ':') -> 0-44 index. Pairs combined (a*45+b) encoded as 11-bit; odd remainder encoded as 6-bit.
+#define QRTINY_MODE_INDICATOR_8_BIT        QRTINY_MODE_8BIT             // 0b0100 8-bit byte
 #define QRTINY_MODE_INDICATOR_TERMINATOR   0x0      // 0b0000 Terminator (End of Message)
 
-#define QRTINY_MODE_NUMERIC_COUNT_BITS      10      // for V1
-#define QRTINY_MODE_ALPHANUMERIC_COUNT_BITS  9      // for V1
-#define QRTINY_MODE_8BIT_COUNT_BITS          8      // for V1
-// Segment buffer sizes (payload, 4-bit mode indicator, V1 sized char count)
+#define QRTINY_MODE_NUMERIC_COUNT_BITS      10      // for V1-V9
+#define QRTINY_MODE_ALPHANUMERIC_COUNT_BITS  9      // for V1-V9
+#define QRTINY_MODE_8BIT_COUNT_BITS          8      // for V1-V9
+// Segment buffer sizes (payload, 4-bit mode indicator, V1-V9 sized char count)
 #define QRTINY_SEGMENT_NUMERIC_BUFFER_BITS(_c) (QRTINY_SIZE_MODE_INDICATOR + QRTINY_MODE_NUMERIC_COUNT_BITS + (10 * ((_c) / 3)) + (((_c) % 3) * 4) - (((_c) % 3) / 2))
 #define QRTINY_SEGMENT_ALPHANUMERIC_BUFFER_BITS(_c) (QRTINY_SIZE_MODE_INDICATOR + QRTINY_MODE_ALPHANUMERIC_COUNT_BITS + 11 * ((_c) >> 1) + 6 * ((_c) & 1))
 #define QRTINY_SEGMENT_8_BIT_BUFFER_BITS(_c) (QRTINY_SIZE_MODE_INDICATOR + QRTINY_MODE_8BIT_COUNT_BITS + 8 * (_c))
 
-size_t QrTinyWriteNumeric(void *buffer, size_t bitPosition, const char *text)
+// Character values and classes: alphanumeric value 0-44 (lower-case letters share the upper-case values, as a convenience), plus whether strictly alphanumeric/numeric
+#define QRTINY_CHARACTER_VALUE 0x3f
+#define QRTINY_CHARACTER_ALPHANUMERIC 0x40
+#define QRTINY_CHARACTER_NUMERIC 0x80
+static const uint8_t qrtinyCharacters[256] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x64, 0x00, 0x00, 0x00, 0x65, 0x66, 0x00, 0x00, 0x00, 0x00, 0x67, 0x68, 0x00, 0x69, 0x6a, 0x6b,
+    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0x6c, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+    0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+size_t QrTinyWriteNumericN(void *buffer, size_t bitPosition, const char *data, size_t length)
 {
-    size_t charCount = strlen(text);
-    size_t bitsWritten = 0;
-    bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, QRTINY_MODE_INDICATOR_NUMERIC, QRTINY_SIZE_MODE_INDICATOR);
-    bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, (uint32_t)charCount, QRTINY_MODE_NUMERIC_COUNT_BITS);
-    for (size_t i = 0; i < charCount; )
-    {
-        size_t remain = (charCount - i) > 3 ? 3 : (charCount - i);
-        int value = text[i] - '0';
-        int bits = 4;
-        // Maximal groups of 3/2/1 digits encoded to 10/7/4-bit binary
-        if (remain > 1) { value = value * 10 + text[i + 1] - '0'; bits += 3; }
-        if (remain > 2) { value = value * 10 + text[i + 2] - '0'; bits += 3; }
-        bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, value, bits);
-        i += remain;
+    QRTINY_STATS_BEGIN(WRITE);
+    qrtiny_writer_t writer;
+    QrTinyWriterStart(&writer, buffer, bitPosition);
+    QrTinyWriterAppend(&writer, QRTINY_MODE_INDICATOR_NUMERIC, QRTINY_SIZE_MODE_INDICATOR);
+    QrTinyWriterAppend(&writer, (uint32_t)length, QRTINY_MODE_NUMERIC_COUNT_BITS);
+    size_t i = 0;
+    // Maximal groups of 3/2/1 digits encoded to 10/7/4-bit binary
+    for (; i + 3 <= length; i += 3)
+    {
+        QrTinyWriterAppend(&writer, (uint32_t)((data[i] - '0') * 100 + (data[i + 1] - '0') * 10 + (data[i + 2] - '0')), 10);
     }
-    return bitsWritten;
+    if (length - i == 2) QrTinyWriterAppend(&writer, (uint32_t)((data[i] - '0') * 10 + (data[i + 1] - '0')), 7);
+    else if (length - i == 1) QrTinyWriterAppend(&writer, (uint32_t)(data[i] - '0'), 4);
+    QrTinyWriterEnd(&writer);
+    QRTINY_STATS_END(WRITE);
+    return QRTINY_SEGMENT_NUMERIC_BUFFER_BITS(length);
 }
 
-size_t QrTinyWriteAlphanumeric(void *buffer, size_t bitPosition, const char *text)
+size_t QrTinyWriteAlphanumericN(void *buffer, size_t bitPosition, const char *data, size_t length)
 {
-    static const char *symbols = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
-    size_t charCount = strlen(text);
-    size_t bitsWritten = 0;
-    bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, QRTINY_MODE_INDICATOR_ALPHANUMERIC, QRTINY_SIZE_MODE_INDICATOR);
-    bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, (uint32_t)charCount, QRTINY_MODE_ALPHANUMERIC_COUNT_BITS);
-    for (size_t i = 0; i < charCount; )
+    const uint8_t *text = (const uint8_t *)data;
+    QRTINY_STATS_BEGIN(WRITE);
+    qrtiny_writer_t writer;
+    QrTinyWriterStart(&writer, buffer, bitPosition);
+    QrTinyWriterAppend(&writer, QRTINY_MODE_INDICATOR_ALPHANUMERIC, QRTINY_SIZE_MODE_INDICATOR);
+    QrTinyWriterAppend(&writer, (uint32_t)length, QRTINY_MODE_ALPHANUMERIC_COUNT_BITS);
+    size_t i = 0;
+    // Pairs combined (a * 45 + b) encoded as 11-bit; odd remainder encoded as 6-bit.
+    for (; i + 2 <= length; i += 2)
     {
-        size_t remain = (charCount - i) > 2 ? 2 : (charCount - i);
-        char c = text[i];
-        int value = (int)(strchr(symbols, (c >= 'a' && c <= 'z') ? c + 'A' - 'a' : c) - symbols);
-        int bits = 6;
-        // Pairs combined(a * 45 + b) encoded as 11 - bit; odd remainder encoded as 6 - bit.
-        if (remain > 1)
-        {
-            c = text[i + 1];
-            value *= 45;
-            value += (int)(strchr(symbols, (c >= 'a' && c <= 'z') ? c + 'A' - 'a' : c) - symbols);
-            bits += 5;
-        }
-        bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, value, bits);
-        i += remain;
+        QrTinyWriterAppend(&writer, (uint32_t)(qrtinyCharacters[text[i]] & QRTINY_CHARACTER_VALUE) * 45 + (qrtinyCharacters[text[i + 1]] & QRTINY_CHARACTER_VALUE), 11);
     }
-    return bitsWritten;
+    if (i < length) QrTinyWriterAppend(&writer, qrtinyCharacters[text[i]] & QRTINY_CHARACTER_VALUE, 6);
+    QrTinyWriterEnd(&writer);
+    QRTINY_STATS_END(WRITE);
+    return QRTINY_SEGMENT_ALPHANUMERIC_BUFFER_BITS(length);
 }
 
-size_t QrTinyWrite8Bit(void *buffer, size_t bitPosition, const char *text)
+size_t QrTinyWrite8BitN(void *buffer, size_t bitPosition, const char *data, size_t length)
 {
-    size_t charCount = strlen(text);
-    size_t bitsWritten = 0;
-    bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, QRTINY_MODE_INDICATOR_8_BIT, QRTINY_SIZE_MODE_INDICATOR);
-    bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, (uint32_t)charCount, QRTINY_MODE_8BIT_COUNT_BITS);
-    for (size_t i = 0; i < charCount; i++)
+    const uint8_t *text = (const uint8_t *)data;
+    QRTINY_STATS_BEGIN(WRITE);
+    qrtiny_writer_t writer;
+    QrTinyWriterStart(&writer, buffer, bitPosition);
+    QrTinyWriterAppend(&writer, QRTINY_MODE_INDICATOR_8_BIT, QRTINY_SIZE_MODE_INDICATOR);
+    QrTinyWriterAppend(&writer, (uint32_t)length, QRTINY_MODE_8BIT_COUNT_BITS);
+    for (size_t i = 0; i < length; i++)
     {
-        bitsWritten += QrTinyBufferAppend(buffer, bitPosition + bitsWritten, text[i], 8);
+        QrTinyWriterAppend(&writer, text[i], 8);
     }
-    return bitsWritten;
+    QrTinyWriterEnd(&writer);
+    QRTINY_STATS_END(WRITE);
+    return QRTINY_SEGMENT_8_BIT_BUFFER_BITS(length);
+}
+
+size_t QrTinyWriteNumeric(void *buffer, size_t bitPosition, const char *text)
+{
+    return QrTinyWriteNumericN(buffer, bitPosition, text, strlen(text));
+}
+
+size_t QrTinyWriteAlphanumeric(void *buffer, size_t bitPosition, const char *text)
+{
+    return QrTinyWriteAlphanumericN(buffer, bitPosition, text, strlen(text));
+}
+
+size_t QrTinyWrite8Bit(void *buffer, size_t bitPosition, const char *text)
+{
+    return QrTinyWrite8BitN(buffer, bitPosition, text, strlen(text));
 }
 
 #define QRTINY_FINDER_SIZE 7
 #define QRTINY_TIMING_OFFSET 6
 #define QRTINY_VERSION_SIZE 3
 #define QRTINY_ALIGNMENT_RADIUS 2
+#define QRTINY_ALIGNMENT_OFFSET 6                   // V2-V6: a single alignment pattern, centred this far from the right and bottom edges
 
+#if QRTINY_VERSION == 1
 // Determine the data bit index for a V1 QR Code at a given coordinate (only valid at data module coordinates).
 static size_t QrTinyIdentifyIndex(int x, int y)
 {
@@ -130,6 +279,9 @@ static size_t QrTinyIdentifyIndex(int x, int y)
     int bit = (((dir ? 0x0 : 0x3) ^ (yy & 3)) << 1) + half;
     return ((module << 3) | bit);
 }
+#else
+static size_t QrTinyIdentifyIndex(int x, int y);    // From the tables of data modules (below)
+#endif
 
 // Determines whether a specified module coordinate is light/dark or part of the data
 static int QrTinyIdentifyModule(int x, int y, uint16_t formatInfo)
@@ -152,6 +304,16 @@ static int QrTinyIdentifyModule(int x, int y, uint16_t formatInfo)
     // Timing
     if (x == QRTINY_TIMING_OFFSET || y == QRTINY_TIMING_OFFSET) { return ((x^y)&1) ? QRTINY_MODULE_LIGHT : QRTINY_MODULE_DARK; } // Timing: vertical
 
+#if QRTINY_VERSION > 1
+    // Alignment
+    int ax = abs(x - (QRTINY_DIMENSION - 1 - QRTINY_ALIGNMENT_OFFSET));
+    int ay = abs(y - (QRTINY_DIMENSION - 1 - QRTINY_ALIGNMENT_OFFSET));
+    if (ax <= QRTINY_ALIGNMENT_RADIUS && ay <= QRTINY_ALIGNMENT_RADIUS)
+    {
+        return (ax > ay ? ax : ay) == 1 ? QRTINY_MODULE_LIGHT : QRTINY_MODULE_DARK;
+    }
+#endif
+
     // Coordinates skipping timing
     int xx = x - ((x >= QRTINY_TIMING_OFFSET) ? 1 : 0);
     int yy = y - ((y >= QRTINY_TIMING_OFFSET) ? 1 : 0);
@@ -189,6 +351,92 @@ static bool QrTinyCalculateMask(uint16_t formatInfo, int j, int i)
 }
 
 // --- Reed-Solomon Error-Correction Code ---
+
+#ifdef QRTINY_RS_TABLES
+// Table-driven version (define QRTINY_RS_TABLES): faster, at the cost of 768 bytes of constant tables and a stack ring buffer.
+// Exponents of the generator 0x02 in GF(2^8/0x011D), repeated so that the sum of two logarithms does not need reducing modulo 255
+static const uint8_t qrtinyGFExp[512] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1d, 0x3a, 0x74, 0xe8, 0xcd, 0x87, 0x13, 0x26,
+    0x4c, 0x98, 0x2d, 0x5a, 0xb4, 0x75, 0xea, 0xc9, 0x8f, 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0xc0,
+    0x9d, 0x27, 0x4e, 0x9c, 0x25, 0x4a, 0x94, 0x35, 0x6a, 0xd4, 0xb5, 0x77, 0xee, 0xc1, 0x9f, 0x23,
+    0x46, 0x8c, 0x05, 0x0a, 0x14, 0x28, 0x50, 0xa0, 0x5d, 0xba, 0x69, 0xd2, 0xb9, 0x6f, 0xde, 0xa1,
+    0x5f, 0xbe, 0x61, 0xc2, 0x99, 0x2f, 0x5e, 0xbc, 0x65, 0xca, 0x89, 0x0f, 0x1e, 0x3c, 0x78, 0xf0,
+    0xfd, 0xe7, 0xd3, 0xbb, 0x6b, 0xd6, 0xb1, 0x7f, 0xfe, 0xe1, 0xdf, 0xa3, 0x5b, 0xb6, 0x71, 0xe2,
+    0xd9, 0xaf, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0d, 0x1a, 0x34, 0x68, 0xd0, 0xbd, 0x67, 0xce,
+    0x81, 0x1f, 0x3e, 0x7c, 0xf8, 0xed, 0xc7, 0x93, 0x3b, 0x76, 0xec, 0xc5, 0x97, 0x33, 0x66, 0xcc,
+    0x85, 0x17, 0x2e, 0x5c, 0xb8, 0x6d, 0xda, 0xa9, 0x4f, 0x9e, 0x21, 0x42, 0x84, 0x15, 0x2a, 0x54,
+    0xa8, 0x4d, 0x9a, 0x29, 0x52, 0xa4, 0x55, 0xaa, 0x49, 0x92, 0x39, 0x72, 0xe4, 0xd5, 0xb7, 0x73,
+    0xe6, 0xd1, 0xbf, 0x63, 0xc6, 0x91, 0x3f, 0x7e, 0xfc, 0xe5, 0xd7, 0xb3, 0x7b, 0xf6, 0xf1, 0xff,
+    0xe3, 0xdb, 0xab, 0x4b, 0x96, 0x31, 0x62, 0xc4, 0x95, 0x37, 0x6e, 0xdc, 0xa5, 0x57, 0xae, 0x41,
+    0x82, 0x19, 0x32, 0x64, 0xc8, 0x8d, 0x07, 0x0e, 0x1c, 0x38, 0x70, 0xe0, 0xdd, 0xa7, 0x53, 0xa6,
+    0x51, 0xa2, 0x59, 0xb2, 0x79, 0xf2, 0xf9, 0xef, 0xc3, 0x9b, 0x2b, 0x56, 0xac, 0x45, 0x8a, 0x09,
+    0x12, 0x24, 0x48, 0x90, 0x3d, 0x7a, 0xf4, 0xf5, 0xf7, 0xf3, 0xfb, 0xeb, 0xcb, 0x8b, 0x0b, 0x16,
+    0x2c, 0x58, 0xb0, 0x7d, 0xfa, 0xe9, 0xcf, 0x83, 0x1b, 0x36, 0x6c, 0xd8, 0xad, 0x47, 0x8e, 0x01,
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1d, 0x3a, 0x74, 0xe8, 0xcd, 0x87, 0x13, 0x26, 0x4c,
+    0x98, 0x2d, 0x5a, 0xb4, 0x75, 0xea, 0xc9, 0x8f, 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0xc0, 0x9d,
+    0x27, 0x4e, 0x9c, 0x25, 0x4a, 0x94, 0x35, 0x6a, 0xd4, 0xb5, 0x77, 0xee, 0xc1, 0x9f, 0x23, 0x46,
+    0x8c, 0x05, 0x0a, 0x14, 0x28, 0x50, 0xa0, 0x5d, 0xba, 0x69, 0xd2, 0xb9, 0x6f, 0xde, 0xa1, 0x5f,
+    0xbe, 0x61, 0xc2, 0x99, 0x2f, 0x5e, 0xbc, 0x65, 0xca, 0x89, 0x0f, 0x1e, 0x3c, 0x78, 0xf0, 0xfd,
+    0xe7, 0xd3, 0xbb, 0x6b, 0xd6, 0xb1, 0x7f, 0xfe, 0xe1, 0xdf, 0xa3, 0x5b, 0xb6, 0x71, 0xe2, 0xd9,
+    0xaf, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0d, 0x1a, 0x34, 0x68, 0xd0, 0xbd, 0x67, 0xce, 0x81,
+    0x1f, 0x3e, 0x7c, 0xf8, 0xed, 0xc7, 0x93, 0x3b, 0x76, 0xec, 0xc5, 0x97, 0x33, 0x66, 0xcc, 0x85,
+    0x17, 0x2e, 0x5c, 0xb8, 0x6d, 0xda, 0xa9, 0x4f, 0x9e, 0x21, 0x42, 0x84, 0x15, 0x2a, 0x54, 0xa8,
+    0x4d, 0x9a, 0x29, 0x52, 0xa4, 0x55, 0xaa, 0x49, 0x92, 0x39, 0x72, 0xe4, 0xd5, 0xb7, 0x73, 0xe6,
+    0xd1, 0xbf, 0x63, 0xc6, 0x91, 0x3f, 0x7e, 0xfc, 0xe5, 0xd7, 0xb3, 0x7b, 0xf6, 0xf1, 0xff, 0xe3,
+    0xdb, 0xab, 0x4b, 0x96, 0x31, 0x62, 0xc4, 0x95, 0x37, 0x6e, 0xdc, 0xa5, 0x57, 0xae, 0x41, 0x82,
+    0x19, 0x32, 0x64, 0xc8, 0x8d, 0x07, 0x0e, 0x1c, 0x38, 0x70, 0xe0, 0xdd, 0xa7, 0x53, 0xa6, 0x51,
+    0xa2, 0x59, 0xb2, 0x79, 0xf2, 0xf9, 0xef, 0xc3, 0x9b, 0x2b, 0x56, 0xac, 0x45, 0x8a, 0x09, 0x12,
+    0x24, 0x48, 0x90, 0x3d, 0x7a, 0xf4, 0xf5, 0xf7, 0xf3, 0xfb, 0xeb, 0xcb, 0x8b, 0x0b, 0x16, 0x2c,
+    0x58, 0xb0, 0x7d, 0xfa, 0xe9, 0xcf, 0x83, 0x1b, 0x36, 0x6c, 0xd8, 0xad, 0x47, 0x8e, 0x01, 0x02,
+};
+
+// Logarithms (base 0x02) in GF(2^8/0x011D), the entry for zero is unused
+static const uint8_t qrtinyGFLog[256] = {
+    0x00, 0x00, 0x01, 0x19, 0x02, 0x32, 0x1a, 0xc6, 0x03, 0xdf, 0x33, 0xee, 0x1b, 0x68, 0xc7, 0x4b,
+    0x04, 0x64, 0xe0, 0x0e, 0x34, 0x8d, 0xef, 0x81, 0x1c, 0xc1, 0x69, 0xf8, 0xc8, 0x08, 0x4c, 0x71,
+    0x05, 0x8a, 0x65, 0x2f, 0xe1, 0x24, 0x0f, 0x21, 0x35, 0x93, 0x8e, 0xda, 0xf0, 0x12, 0x82, 0x45,
+    0x1d, 0xb5, 0xc2, 0x7d, 0x6a, 0x27, 0xf9, 0xb9, 0xc9, 0x9a, 0x09, 0x78, 0x4d, 0xe4, 0x72, 0xa6,
+    0x06, 0xbf, 0x8b, 0x62, 0x66, 0xdd, 0x30, 0xfd, 0xe2, 0x98, 0x25, 0xb3, 0x10, 0x91, 0x22, 0x88,
+    0x36, 0xd0, 0x94, 0xce, 0x8f, 0x96, 0xdb, 0xbd, 0xf1, 0xd2, 0x13, 0x5c, 0x83, 0x38, 0x46, 0x40,
+    0x1e, 0x42, 0xb6, 0xa3, 0xc3, 0x48, 0x7e, 0x6e, 0x6b, 0x3a, 0x28, 0x54, 0xfa, 0x85, 0xba, 0x3d,
+    0xca, 0x5e, 0x9b, 0x9f, 0x0a, 0x15, 0x79, 0x2b, 0x4e, 0xd4, 0xe5, 0xac, 0x73, 0xf3, 0xa7, 0x57,
+    0x07, 0x70, 0xc0, 0xf7, 0x8c, 0x80, 0x63, 0x0d, 0x67, 0x4a, 0xde, 0xed, 0x31, 0xc5, 0xfe, 0x18,
+    0xe3, 0xa5, 0x99, 0x77, 0x26, 0xb8, 0xb4, 0x7c, 0x11, 0x44, 0x92, 0xd9, 0x23, 0x20, 0x89, 0x2e,
+    0x37, 0x3f, 0xd1, 0x5b, 0x95, 0xbc, 0xcf, 0xcd, 0x90, 0x87, 0x97, 0xb2, 0xdc, 0xfc, 0xbe, 0x61,
+    0xf2, 0x56, 0xd3, 0xab, 0x14, 0x2a, 0x5d, 0x9e, 0x84, 0x3c, 0x39, 0x53, 0x47, 0x6d, 0x41, 0xa2,
+    0x1f, 0x2d, 0x43, 0xd8, 0xb7, 0x7b, 0xa4, 0x76, 0xc4, 0x17, 0x49, 0xec, 0x7f, 0x0c, 0x6f, 0xf6,
+    0x6c, 0xa1, 0x3b, 0x52, 0x29, 0x9d, 0x55, 0xaa, 0xfb, 0x60, 0x86, 0xb1, 0xbb, 0xcc, 0x3e, 0x5a,
+    0xcb, 0x59, 0x5f, 0xb0, 0x9c, 0xa9, 0xa0, 0x51, 0x0b, 0xf5, 0x16, 0xeb, 0x7a, 0x75, 0x2c, 0xd7,
+    0x4f, 0xae, 0xd5, 0xe9, 0xe6, 0xe7, 0xad, 0xe8, 0x74, 0xd6, 0xf4, 0xea, 0xa8, 0x50, 0x58, 0xaf,
+};
+
+static void QrTinyRSRemainder(const uint8_t data[], size_t dataLen, const uint8_t generator[], int degree, uint8_t result[])
+{
+    // Generator coefficients (all non-zero) as logarithms
+    uint8_t generatorLog[QRTINY_ECC_CODEWORDS_MAX];
+    for (int j = 0; j < degree; j++)
+    {
+        generatorLog[j] = qrtinyGFLog[generator[j]];
+    }
+
+    // Remainder as a ring buffer starting at 'head', rather than shifting it for each data codeword
+    uint8_t remainder[QRTINY_ECC_CODEWORDS_MAX] = { 0 };
+    int head = 0;
+    for (size_t i = 0; i < dataLen; i++)
+    {
+        uint8_t factor = data[i] ^ remainder[head];
+        remainder[head] = 0;    // Becomes the last term of the shifted remainder
+        if (++head >= degree) head = 0;
+        if (factor == 0) continue;
+        const uint8_t *exp = qrtinyGFExp + qrtinyGFLog[factor];
+        int j = 0;
+        for (int k = head; k < degree; k++, j++) remainder[k] ^= exp[generatorLog[j]];
+        for (int k = 0; k < head; k++, j++) remainder[k] ^= exp[generatorLog[j]];
+    }
+    memcpy(result, remainder + head, (size_t)(degree - head) * sizeof(result[0]));
+    memcpy(result + (degree - head), remainder, (size_t)head * sizeof(result[0]));
+}
+#else
 // This error-correction calculation derived from https://www.nayuki.io/page/qr-code-generator-library Copyright (c) Project Nayuki. (MIT License)
 static void QrTinyRSRemainder(const uint8_t data[], size_t dataLen, const uint8_t generator[], int degree, uint8_t result[])
 {
@@ -211,73 +459,1758 @@ static void QrTinyRSRemainder(const uint8_t data[], size_t dataLen, const uint8_
         }
     }
 }
+#endif
 
-#define QRTINY_ECC_CODEWORDS_MAX 17
-// [Table 13] Number of error correction codewords (count of data 8-bit codewords in each block; for each error-correction level in V1)
-static const int8_t qrcode_ecc_block_codewords[1 << QRTINY_SIZE_ECL] = {
-    10, // 0b00 Medium
-    7,  // 0b01 Low
-    17, // 0b10 High
-    13, // 0b11 Quartile
-};
-static const uint8_t eccDivisorsMedium[] = { 0xd8, 0xc2, 0x9f, 0x6f, 0xc7, 0x5e, 0x5f, 0x71, 0x9d, 0xc1 }; // V1 0b00 Medium ECL
-static const uint8_t eccDivisorsLow[] = { 0x7f, 0x7a, 0x9a, 0xa4, 0x0b, 0x44, 0x75 }; // V1 0b01 Low ECL
-static const uint8_t eccDivisorsHigh[] = { 0x77, 0x42, 0x53, 0x78, 0x77, 0x16, 0xc5, 0x53, 0xf9, 0x29, 0x8f, 0x86, 0x55, 0x35, 0x7d, 0x63, 0x4f }; // V1 0b10 High ECL
-static const uint8_t eccDivisorsQuartile[] = { 0x89, 0x49, 0xe3, 0x11, 0xb1, 0x11, 0x34, 0x0d, 0x2e, 0x2b, 0x53, 0x84, 0x78 }; // V1 0b11 Quartile ECL
+// [Table 9] Number of error correction codewords in each block, and number of blocks (for each error-correction level)
+static const int8_t qrcode_ecc_block_codewords[1 << QRTINY_SIZE_ECL] = { QRTINY_ECC_BLOCK_CODEWORDS };
+static const int8_t qrcode_ecc_blocks[1 << QRTINY_SIZE_ECL] = { QRTINY_ECC_BLOCKS };
+static const uint8_t eccDivisorsMedium[] = { QRTINY_ECC_DIVISORS_MEDIUM };
+static const uint8_t eccDivisorsLow[] = { QRTINY_ECC_DIVISORS_LOW };
+static const uint8_t eccDivisorsHigh[] = { QRTINY_ECC_DIVISORS_HIGH };
+static const uint8_t eccDivisorsQuartile[] = { QRTINY_ECC_DIVISORS_QUARTILE };
 static const uint8_t *eccDivisors[1 << QRTINY_SIZE_ECL] = { eccDivisorsMedium, eccDivisorsLow, eccDivisorsHigh, eccDivisorsQuartile };
 
-// Generate the code
-bool QrTinyGenerate(uint8_t* buffer, size_t payloadLength, uint16_t formatInfo)
+// Total number of data codewords (all blocks)
+static size_t QrTinyDataCodewords(int errorCorrectionLevel)
 {
-    // Number of error correction blocks (count of error-correction-blocks; for each error-correction level in V1)
-    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(formatInfo);
-    int eccCodewords = qrcode_ecc_block_codewords[errorCorrectionLevel]; // (sizeof(eccDivisors[errorCorrectionLevel]) / sizeof(eccDivisors[errorCorrectionLevel][0]));
-    const uint8_t *eccDivisor = eccDivisors[errorCorrectionLevel];
+    return (QRTINY_TOTAL_CAPACITY / 8) - (size_t)qrcode_ecc_block_codewords[errorCorrectionLevel] * (size_t)qrcode_ecc_blocks[errorCorrectionLevel];
+}
 
-    // Total number of data bits available in the codewords (cooked: after ecc and remainder)
-    size_t dataCapacity = ((QRTINY_TOTAL_CAPACITY / 8) - (size_t)eccCodewords) * 8;
+// Position of a buffer codeword in the symbol's codeword sequence: the buffer holds the data codewords (the blocks in turn), then the
+// error-correction codewords (the blocks in turn), whereas the sequence interleaves the blocks, taking one codeword from each in turn.
+static size_t QrTinyCodewordPosition(size_t codeword, int errorCorrectionLevel)
+{
+#if QRTINY_ECC_BLOCKS_MAX > 1
+    size_t blocks = (size_t)qrcode_ecc_blocks[errorCorrectionLevel];
+    size_t dataCodewords = QrTinyDataCodewords(errorCorrectionLevel);
+    size_t start = (codeword < dataCodewords) ? 0 : dataCodewords;
+    size_t blockLength = (codeword < dataCodewords) ? dataCodewords / blocks : (size_t)qrcode_ecc_block_codewords[errorCorrectionLevel];
+    return start + ((codeword - start) % blockLength) * blocks + (codeword - start) / blockLength;
+#else
+    (void)errorCorrectionLevel;
+    return codeword;    // A single block
+#endif
+}
 
-    int spareCapacity = (int)dataCapacity - (int)payloadLength;
-    if (spareCapacity < 0) return false;  // Does not fit
+// Buffer codeword at a position of the symbol's codeword sequence (the inverse of QrTinyCodewordPosition())
+static size_t QrTinyCodewordIndex(size_t position, int errorCorrectionLevel)
+{
+#if QRTINY_ECC_BLOCKS_MAX > 1
+    size_t blocks = (size_t)qrcode_ecc_blocks[errorCorrectionLevel];
+    size_t dataCodewords = QrTinyDataCodewords(errorCorrectionLevel);
+    size_t start = (position < dataCodewords) ? 0 : dataCodewords;
+    size_t blockLength = (position < dataCodewords) ? dataCodewords / blocks : (size_t)qrcode_ecc_block_codewords[errorCorrectionLevel];
+    return start + ((position - start) % blocks) * blockLength + (position - start) / blocks;
+#else
+    (void)errorCorrectionLevel;
+    return position;
+#endif
+}
 
-    // --- Generate final codewords ---
-    // Write data segments
+// Calculate the error-correction codewords of each block, after the data codewords
+static void QrTinyEcc(uint8_t *buffer, int errorCorrectionLevel)
+{
+    int eccCodewords = qrcode_ecc_block_codewords[errorCorrectionLevel];
+    int blocks = qrcode_ecc_blocks[errorCorrectionLevel];
+    size_t dataCodewords = QrTinyDataCodewords(errorCorrectionLevel);
+    size_t blockData = dataCodewords / (size_t)blocks;
+    for (int block = 0; block < blocks; block++)
+    {
+        QrTinyRSRemainder(buffer + (size_t)block * blockData, blockData, eccDivisors[errorCorrectionLevel], eccCodewords, buffer + dataCodewords + (size_t)block * (size_t)eccCodewords);
+    }
+}
+
+// Terminate the payload, and fill the remaining data capacity with padding
+static void QrTinyPad(uint8_t *buffer, size_t payloadLength, size_t dataCapacity)
+{
+    QRTINY_STATS_BEGIN(PAD);
     size_t bitPosition = payloadLength;
+    qrtiny_writer_t writer;
+    QrTinyWriterStart(&writer, buffer, bitPosition);
 
     // Add terminator 4-bit (0b0000)
     size_t remaining = dataCapacity - bitPosition;
     if (remaining > 4) remaining = 4;
-    bitPosition += QrTinyBufferAppend(buffer, bitPosition, QRTINY_MODE_INDICATOR_TERMINATOR, remaining);
+    QrTinyWriterAppend(&writer, QRTINY_MODE_INDICATOR_TERMINATOR, (int)remaining);
+    bitPosition += remaining;
 
     // Round up to a whole byte
     size_t bits = (8 - (bitPosition & 7)) & 7;
     remaining = dataCapacity - bitPosition;
     if (remaining > bits) remaining = bits;
-    bitPosition += QrTinyBufferAppend(buffer, bitPosition, 0, remaining);
+    QrTinyWriterAppend(&writer, 0, (int)remaining);
+    bitPosition += remaining;
 
     // Fill any remaining data space with padding
     while ((remaining = dataCapacity - bitPosition) > 0)
     {
         #define QRTINY_PAD_CODEWORDS 0xec11 // Pad codewords 0b11101100=0xec 0b00010001=0x11
         if (remaining > 16) remaining = 16;
-        bitPosition += QrTinyBufferAppend(buffer, bitPosition, QRTINY_PAD_CODEWORDS >> (16 - remaining), remaining);
+        QrTinyWriterAppend(&writer, QRTINY_PAD_CODEWORDS >> (16 - remaining), (int)remaining);
+        bitPosition += remaining;
     }
+    QrTinyWriterEnd(&writer);
+
+    // Clear the byte of remainder bits (after the last codeword, V2+), so that the buffers of the same symbol are identical
+    for (size_t i = QRTINY_TOTAL_CAPACITY / 8; i < QRTINY_BUFFER_SIZE; i++) buffer[i] = 0;
+    QRTINY_STATS_END(PAD);
+}
+
+// Generate the code
+bool QrTinyGenerate(uint8_t* buffer, size_t payloadLength, uint16_t formatInfo)
+{
+    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(formatInfo);
+
+    // Total number of data bits available in the codewords (cooked: after ecc and remainder)
+    size_t dataCapacity = QrTinyDataCodewords(errorCorrectionLevel) * 8;
+
+    int spareCapacity = (int)dataCapacity - (int)payloadLength;
+    if (spareCapacity < 0) return false;  // Does not fit
+
+    // --- Generate final codewords ---
+    // Write data segments
+    QrTinyPad(buffer, payloadLength, dataCapacity);
 
     // --- Calculate ECC at end of codewords ---
-    // Calculate ECC for the block -- write all consecutively after the data (no interleave required for V1)
-    QrTinyRSRemainder(buffer, dataCapacity / 8, eccDivisor, eccCodewords, buffer + (QRTINY_TOTAL_CAPACITY - ((size_t)8 * eccCodewords)) / 8);
+    // Calculate ECC for each block -- write all consecutively after the data (interleaved only on placement)
+    QRTINY_STATS_BEGIN(ECC);
+    QrTinyEcc(buffer, errorCorrectionLevel);
+    QRTINY_STATS_END(ECC);
+    return true;
+}
+
+// --- Batch generation ---
+// The error-correction codewords of a batch of buffers are calculated together, each buffer's codeword in one byte lane of a
+// vector.  Each generator coefficient multiplies a whole vector of factors at once: the products of the coefficient with each
+// 4-bit value are looked up (with a byte shuffle) for the low and high nibbles of the factors, and combined.
+#if !defined(QRTINY_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define QRTINY_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#ifdef QRTINY_SIMD_X86
+// Product tables for each generator coefficient: the products with 0x00-0x0f, then with 0x00-0xf0
+static void QrTinyNibbleTables(const uint8_t generator[], int degree, uint8_t tables[QRTINY_ECC_CODEWORDS_MAX][32])
+{
+    for (int j = 0; j < degree; j++)
+    {
+        // The coefficient times each power of two, then each table entry as the sum of the products for its set bits
+        uint8_t powers[8];
+        powers[0] = generator[j];
+        for (int k = 1; k < 8; k++) powers[k] = (uint8_t)((powers[k - 1] << 1) ^ ((powers[k - 1] >> 7) * 0x1d));
+        tables[j][0] = tables[j][16] = 0;
+        for (int n = 1; n < 16; n++)
+        {
+            int bit = 0;
+            while (!((n >> bit) & 1)) bit++;
+            tables[j][n] = tables[j][n & (n - 1)] ^ powers[bit];
+            tables[j][16 + n] = tables[j][16 + (n & (n - 1))] ^ powers[4 + bit];
+        }
+    }
+}
+
+// Up to 16 buffers at a time
+__attribute__((target("ssse3")))
+static void QrTinyRSRemainderSSSE3(uint8_t *const buffers[], size_t count, size_t dataOffset, size_t dataLen, size_t eccOffset, const uint8_t tables[QRTINY_ECC_CODEWORDS_MAX][32], int degree)
+{
+    __m128i low[QRTINY_ECC_CODEWORDS_MAX], high[QRTINY_ECC_CODEWORDS_MAX], remainder[QRTINY_ECC_CODEWORDS_MAX];
+    for (int j = 0; j < degree; j++)
+    {
+        low[j] = _mm_loadu_si128((const __m128i *)tables[j]);
+        high[j] = _mm_loadu_si128((const __m128i *)(tables[j] + 16));
+        remainder[j] = _mm_setzero_si128();
+    }
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    uint8_t lanes[16] = { 0 };
+    for (size_t i = 0; i < dataLen; i++)
+    {
+        for (size_t lane = 0; lane < count; lane++) lanes[lane] = buffers[lane][dataOffset + i];
+        __m128i factor = _mm_xor_si128(_mm_loadu_si128((const __m128i *)lanes), remainder[0]);
+        __m128i factorLow = _mm_and_si128(factor, nibble);
+        __m128i factorHigh = _mm_and_si128(_mm_srli_epi16(factor, 4), nibble);
+        for (int j = 0; j < degree; j++)
+        {
+            __m128i product = _mm_xor_si128(_mm_shuffle_epi8(low[j], factorLow), _mm_shuffle_epi8(high[j], factorHigh));
+            remainder[j] = _mm_xor_si128(j + 1 < degree ? remainder[j + 1] : _mm_setzero_si128(), product);
+        }
+    }
+    for (int j = 0; j < degree; j++)
+    {
+        _mm_storeu_si128((__m128i *)lanes, remainder[j]);
+        for (size_t lane = 0; lane < count; lane++) buffers[lane][eccOffset + (size_t)j] = lanes[lane];
+    }
+}
+
+// Up to 32 buffers at a time (the byte shuffle is within each 128-bit half, so the tables are repeated in both)
+__attribute__((target("avx2")))
+static void QrTinyRSRemainderAVX2(uint8_t *const buffers[], size_t count, size_t dataOffset, size_t dataLen, size_t eccOffset, const uint8_t tables[QRTINY_ECC_CODEWORDS_MAX][32], int degree)
+{
+    __m256i low[QRTINY_ECC_CODEWORDS_MAX], high[QRTINY_ECC_CODEWORDS_MAX], remainder[QRTINY_ECC_CODEWORDS_MAX];
+    for (int j = 0; j < degree; j++)
+    {
+        low[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)tables[j]));
+        high[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(tables[j] + 16)));
+        remainder[j] = _mm256_setzero_si256();
+    }
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    uint8_t lanes[32] = { 0 };
+    for (size_t i = 0; i < dataLen; i++)
+    {
+        for (size_t lane = 0; lane < count; lane++) lanes[lane] = buffers[lane][dataOffset + i];
+        __m256i factor = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)lanes), remainder[0]);
+        __m256i factorLow = _mm256_and_si256(factor, nibble);
+        __m256i factorHigh = _mm256_and_si256(_mm256_srli_epi16(factor, 4), nibble);
+        for (int j = 0; j < degree; j++)
+        {
+            __m256i product = _mm256_xor_si256(_mm256_shuffle_epi8(low[j], factorLow), _mm256_shuffle_epi8(high[j], factorHigh));
+            remainder[j] = _mm256_xor_si256(j + 1 < degree ? remainder[j + 1] : _mm256_setzero_si256(), product);
+        }
+    }
+    for (int j = 0; j < degree; j++)
+    {
+        _mm256_storeu_si256((__m256i *)lanes, remainder[j]);
+        for (size_t lane = 0; lane < count; lane++) buffers[lane][eccOffset + (size_t)j] = lanes[lane];
+    }
+}
+#endif
+
+// Buffers per call of the widest supported implementation (1 for the scalar code)
+static int QrTinyBatchLanes(void)
+{
+#ifdef QRTINY_SIMD_X86
+    if (__builtin_cpu_supports("avx2")) return 32;
+    if (__builtin_cpu_supports("ssse3")) return 16;
+#endif
+    return 1;
+}
+
+bool QrTinyGenerateBatch(uint8_t *const buffers[], const size_t payloadLengths[], size_t count, uint16_t formatInfo)
+{
+    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(formatInfo);
+    size_t dataCapacity = QrTinyDataCodewords(errorCorrectionLevel) * 8;
+    for (size_t n = 0; n < count; n++)
+    {
+        if (payloadLengths[n] > dataCapacity) return false;  // Does not fit
+    }
+    for (size_t n = 0; n < count; n++)
+    {
+        QrTinyPad(buffers[n], payloadLengths[n], dataCapacity);
+    }
+
+    QRTINY_STATS_BEGIN(ECC);
+    size_t lanes = (size_t)QrTinyBatchLanes();
+    size_t n = 0;
+#ifdef QRTINY_SIMD_X86
+    if (lanes > 1 && count > 1)
+    {
+        int eccCodewords = qrcode_ecc_block_codewords[errorCorrectionLevel];
+        uint8_t tables[QRTINY_ECC_CODEWORDS_MAX][32];
+        QrTinyNibbleTables(eccDivisors[errorCorrectionLevel], eccCodewords, tables);
+        size_t blocks = (size_t)qrcode_ecc_blocks[errorCorrectionLevel];
+        size_t blockData = dataCapacity / 8 / blocks;
+        for (; n < count; n += lanes)
+        {
+            size_t group = (count - n < lanes) ? count - n : lanes;
+            for (size_t block = 0; block < blocks; block++)
+            {
+                size_t dataOffset = block * blockData, eccOffset = dataCapacity / 8 + block * (size_t)eccCodewords;
+                if (lanes == 32) QrTinyRSRemainderAVX2(buffers + n, group, dataOffset, blockData, eccOffset, tables, eccCodewords);
+                else QrTinyRSRemainderSSSE3(buffers + n, group, dataOffset, blockData, eccOffset, tables, eccCodewords);
+            }
+        }
+    }
+#else
+    (void)lanes;
+#endif
+    for (; n < count; n++)
+    {
+        QrTinyEcc(buffers[n], errorCorrectionLevel);
+    }
+    QRTINY_STATS_END(ECC);
     return true;
 }
 
-int QrTinyModuleGet(uint8_t *buffer, uint16_t formatInfo, int x, int y)
+// --- Segment planning ---
+// Longest text that could fit: all numeric, at the lowest error-correction level
+#define QRTINY_PLAN_LENGTH_MAX ((((QRTINY_TOTAL_CAPACITY / 8) - QRTINY_ECC_CODEWORDS_MIN) * 8 - QRTINY_SIZE_MODE_INDICATOR - QRTINY_MODE_NUMERIC_COUNT_BITS) * 3 / 10)
+
+// Per-character costs in 1/6 bit units (numeric 10/3 bits, alphanumeric 11/2 bits, 8-bit 8 bits), and segment header costs
+#define QRTINY_PLAN_MODES 3
+static const uint8_t qrtinyPlanModes[QRTINY_PLAN_MODES] = { QRTINY_MODE_NUMERIC, QRTINY_MODE_ALPHANUMERIC, QRTINY_MODE_8BIT };
+static const uint8_t qrtinyPlanCharacterClass[QRTINY_PLAN_MODES] = { QRTINY_CHARACTER_NUMERIC, QRTINY_CHARACTER_ALPHANUMERIC, 0 };
+static const uint8_t qrtinyPlanCharacterCost[QRTINY_PLAN_MODES] = { 20, 33, 48 };
+static const uint8_t qrtinyPlanHeaderCost[QRTINY_PLAN_MODES] = {
+    6 * (QRTINY_SIZE_MODE_INDICATOR + QRTINY_MODE_NUMERIC_COUNT_BITS),
+    6 * (QRTINY_SIZE_MODE_INDICATOR + QRTINY_MODE_ALPHANUMERIC_COUNT_BITS),
+    6 * (QRTINY_SIZE_MODE_INDICATOR + QRTINY_MODE_8BIT_COUNT_BITS),
+};
+
+static bool QrTinyPlanSegments(const char *text, size_t length, qrtiny_plan_t *plan)
+{
+    const uint8_t *data = (const uint8_t *)text;
+    plan->segmentCount = 0;
+    plan->bits = 0;
+    plan->ecl = QRTINY_ECL_LOW;
+    if (length > QRTINY_PLAN_LENGTH_MAX) return false;   // Cannot fit
+
+    // Minimal cost of encoding the text so far, ending in each mode (the cost of switching includes the next segment header);
+    // and, for each character and ending mode, the mode the character is encoded in.
+    int cost[QRTINY_PLAN_MODES];
+    uint8_t from[QRTINY_PLAN_LENGTH_MAX][QRTINY_PLAN_MODES];
+    for (int j = 0; j < QRTINY_PLAN_MODES; j++) cost[j] = qrtinyPlanHeaderCost[j];
+    for (size_t i = 0; i < length; i++)
+    {
+        // Encode the character in the current mode, where possible
+        int next[QRTINY_PLAN_MODES];
+        for (int j = 0; j < QRTINY_PLAN_MODES; j++)
+        {
+            bool possible = (qrtinyCharacters[data[i]] & qrtinyPlanCharacterClass[j]) == qrtinyPlanCharacterClass[j];
+            next[j] = possible ? cost[j] + qrtinyPlanCharacterCost[j] : INT_MAX;
+            from[i][j] = (uint8_t)j;
+        }
+        // Switch mode after the character, rounding up to a whole bit, where it is cheaper
+        for (int j = 0; j < QRTINY_PLAN_MODES; j++)
+        {
+            for (int k = 0; k < QRTINY_PLAN_MODES; k++)
+            {
+                if (next[k] == INT_MAX || k == j) continue;
+                int switched = (next[k] + 5) / 6 * 6 + qrtinyPlanHeaderCost[j];
+                if (switched < next[j])
+                {
+                    next[j] = switched;
+                    from[i][j] = (uint8_t)k;
+                }
+            }
+        }
+        memcpy(cost, next, sizeof(cost));
+    }
+
+    // Trace back from the cheapest final mode, counting characters into segments (in reverse)
+    int mode = 0;
+    for (int j = 1; j < QRTINY_PLAN_MODES; j++)
+    {
+        if (cost[j] < cost[mode]) mode = j;
+    }
+    int currentSegmentMode = -1;
+    for (size_t i = length; i-- > 0; )
+    {
+        mode = from[i][mode];
+        if (mode != currentSegmentMode)
+        {
+            if (plan->segmentCount >= QRTINY_PLAN_SEGMENTS_MAX)
+            {
+                // Out of segments: the last one (in reverse) takes the rest of the text in 8-bit mode, which can encode any character
+                plan->segments[plan->segmentCount - 1].mode = QRTINY_MODE_8BIT;
+                plan->segments[plan->segmentCount - 1].length += (uint8_t)(i + 1);
+                if (plan->segmentCount > 1 && plan->segments[plan->segmentCount - 2].mode == QRTINY_MODE_8BIT)
+                {
+                    plan->segments[plan->segmentCount - 2].length += plan->segments[plan->segmentCount - 1].length;
+                    plan->segmentCount--;
+                }
+                break;
+            }
+            plan->segments[plan->segmentCount].mode = qrtinyPlanModes[mode];
+            plan->segments[plan->segmentCount].length = 0;
+            plan->segmentCount++;
+            currentSegmentMode = mode;
+        }
+        plan->segments[plan->segmentCount - 1].length++;
+    }
+
+    // Reverse into text order, and total the exact number of bits
+    for (int i = 0; i < plan->segmentCount / 2; i++)
+    {
+        qrtiny_segment_t swap = plan->segments[i];
+        plan->segments[i] = plan->segments[plan->segmentCount - 1 - i];
+        plan->segments[plan->segmentCount - 1 - i] = swap;
+    }
+    for (int i = 0; i < plan->segmentCount; i++)
+    {
+        size_t count = plan->segments[i].length;
+        switch (plan->segments[i].mode)
+        {
+            case QRTINY_MODE_NUMERIC: plan->bits += QRTINY_SEGMENT_NUMERIC_BUFFER_BITS(count); break;
+            case QRTINY_MODE_ALPHANUMERIC: plan->bits += QRTINY_SEGMENT_ALPHANUMERIC_BUFFER_BITS(count); break;
+            default: plan->bits += QRTINY_SEGMENT_8_BIT_BUFFER_BITS(count); break;
+        }
+    }
+
+    // Having run out of segments, the whole text as one 8-bit segment may be shorter
+    if (plan->bits > QRTINY_SEGMENT_8_BIT_BUFFER_BITS(length))
+    {
+        plan->segments[0].mode = QRTINY_MODE_8BIT;
+        plan->segments[0].length = (uint8_t)length;
+        plan->segmentCount = 1;
+        plan->bits = QRTINY_SEGMENT_8_BIT_BUFFER_BITS(length);
+    }
+
+    // Strongest error-correction level with the capacity for the data
+    static const int8_t eclStrongest[1 << QRTINY_SIZE_ECL] = { QRTINY_ECL_HIGH, QRTINY_ECL_QUARTILE, QRTINY_ECL_MEDIUM, QRTINY_ECL_LOW };
+    for (int i = 0; i < (1 << QRTINY_SIZE_ECL); i++)
+    {
+        size_t dataCapacity = QrTinyDataCodewords(eclStrongest[i]) * 8;
+        if (plan->bits <= dataCapacity)
+        {
+            plan->ecl = eclStrongest[i];
+            return true;
+        }
+    }
+    return false;   // Does not fit
+}
+
+bool QrTinyPlan(const char *text, size_t length, qrtiny_plan_t *plan)
+{
+    QRTINY_STATS_BEGIN(PLAN);
+    bool result = QrTinyPlanSegments(text, length, plan);
+    QRTINY_STATS_END(PLAN);
+    return result;
+}
+
+size_t QrTinyPlanWrite(void *buffer, size_t bitPosition, const char *text, const qrtiny_plan_t *plan)
+{
+    size_t bitsWritten = 0;
+    for (int i = 0; i < plan->segmentCount; i++)
+    {
+        size_t count = plan->segments[i].length;
+        switch (plan->segments[i].mode)
+        {
+            case QRTINY_MODE_NUMERIC: bitsWritten += QrTinyWriteNumericN(buffer, bitPosition + bitsWritten, text, count); break;
+            case QRTINY_MODE_ALPHANUMERIC: bitsWritten += QrTinyWriteAlphanumericN(buffer, bitPosition + bitsWritten, text, count); break;
+            default: bitsWritten += QrTinyWrite8BitN(buffer, bitPosition + bitsWritten, text, count); break;
+        }
+        text += count;
+    }
+    return bitsWritten;
+}
+
+int QrTinyModuleGet(const uint8_t *buffer, uint16_t formatInfo, int x, int y)
 {
     int type = QrTinyIdentifyModule(x, y, formatInfo);
     if (type == QRTINY_MODULE_DATA)
     {
-        int index = QrTinyIdentifyIndex(x, y);
-        type = (buffer[index >> 3] & (1 << (index & 7))) ? 1 : 0;
+        size_t index = QrTinyIdentifyIndex(x, y);
+        if ((QRTINY_TOTAL_CAPACITY & 7) == 0 || (index >> 3) < QRTINY_TOTAL_CAPACITY / 8)    // Not a remainder bit (V2-V6 have seven)
+        {
+            size_t codeword = QrTinyCodewordIndex(index >> 3, QRTINY_FORMATINFO_TO_ECL(formatInfo));
+            type = (buffer[codeword] & (1 << (index & 7))) ? 1 : 0;
+        }
+        else type = 0;
         bool mask = QrTinyCalculateMask(formatInfo, x, y);
         if (mask) type ^= 1;
     }
     return type;
 }
+
+qrtiny_quiet_row_t QrTinyRowGet(const uint8_t *buffer, uint16_t formatInfo, int y, int quiet)
+{
+    if (quiet < 0 || quiet > QRTINY_QUIET_STANDARD || y < 0 || y >= QRTINY_DIMENSION) return 0;     // Invalid margin, or a quiet row
+    qrtiny_row_t all = ((qrtiny_row_t)2 << (QRTINY_DIMENSION - 1)) - 1;
+    qrtiny_row_t function = 0;  // Function modules of the row
+    qrtiny_row_t dark = 0;      // ...of which are dark
+    #define QRTINY_ROW_ADD(_mask, _dark) do { qrtiny_row_t _m = (_mask) & ~function; dark |= (_dark) & _m; function |= _m; } while (0)
+
+    // Finders (and their separators): the pattern across a finder for its distance from the row at its centre
+    int fy = (y <= QRTINY_FINDER_SIZE) ? y : (y >= QRTINY_DIMENSION - 1 - QRTINY_FINDER_SIZE) ? QRTINY_DIMENSION - 1 - y : -1;
+    if (fy >= 0)
+    {
+        int dy = abs(fy - QRTINY_FINDER_SIZE / 2);
+        qrtiny_row_t finder = (dy > 3) ? 0x00 : (dy == 3) ? 0x7f : (dy == 2) ? 0x41 : 0x5d;
+        QRTINY_ROW_ADD(0xff, finder);
+        if (y <= QRTINY_FINDER_SIZE) QRTINY_ROW_ADD((qrtiny_row_t)0xff << (QRTINY_DIMENSION - QRTINY_FINDER_SIZE - 1), finder << (QRTINY_DIMENSION - QRTINY_FINDER_SIZE));
+    }
+
+    // Timing
+    if (y == QRTINY_TIMING_OFFSET) QRTINY_ROW_ADD(all, (qrtiny_row_t)0x5555555555555555ull);
+    else QRTINY_ROW_ADD((qrtiny_row_t)1 << QRTINY_TIMING_OFFSET, (qrtiny_row_t)((y & 1) ^ 1) << QRTINY_TIMING_OFFSET);
+
+#if QRTINY_VERSION > 1
+    // Alignment
+    int ay = abs(y - (QRTINY_DIMENSION - 1 - QRTINY_ALIGNMENT_OFFSET));
+    if (ay <= QRTINY_ALIGNMENT_RADIUS)
+    {
+        int left = QRTINY_DIMENSION - 1 - QRTINY_ALIGNMENT_OFFSET - QRTINY_ALIGNMENT_RADIUS;
+        QRTINY_ROW_ADD((qrtiny_row_t)0x1f << left, (qrtiny_row_t)((ay == 2) ? 0x1f : (ay == 1) ? 0x11 : 0x15) << left);
+    }
+#endif
+
+    // Format info (the row below the top finders, or the column right of the left finders), and the always-dark module
+    int yy = y - ((y >= QRTINY_TIMING_OFFSET) ? 1 : 0);
+    if (y == QRTINY_FINDER_SIZE + 1)
+    {
+        for (int x = 0; x <= QRTINY_FINDER_SIZE + 1; x++)
+        {
+            int xx = x - ((x >= QRTINY_TIMING_OFFSET) ? 1 : 0);
+            QRTINY_ROW_ADD((qrtiny_row_t)1 << x, (qrtiny_row_t)((formatInfo >> (7 - xx + yy)) & 1) << x);
+        }
+        for (int x = QRTINY_DIMENSION - QRTINY_FINDER_SIZE - 1; x < QRTINY_DIMENSION; x++)
+        {
+            QRTINY_ROW_ADD((qrtiny_row_t)1 << x, (qrtiny_row_t)((formatInfo >> (QRTINY_DIMENSION - 1 - x)) & 1) << x);
+        }
+    }
+    else if (y <= QRTINY_FINDER_SIZE)
+    {
+        QRTINY_ROW_ADD((qrtiny_row_t)1 << (QRTINY_FINDER_SIZE + 1), (qrtiny_row_t)((formatInfo >> yy) & 1) << (QRTINY_FINDER_SIZE + 1));
+    }
+    else if (y >= QRTINY_DIMENSION - QRTINY_FINDER_SIZE - 1)
+    {
+        int bit = (y == QRTINY_DIMENSION - QRTINY_FINDER_SIZE - 1) ? 1 : (formatInfo >> (y + 14 - (QRTINY_DIMENSION - 1))) & 1;
+        QRTINY_ROW_ADD((qrtiny_row_t)1 << (QRTINY_FINDER_SIZE + 1), (qrtiny_row_t)bit << (QRTINY_FINDER_SIZE + 1));
+    }
+    #undef QRTINY_ROW_ADD
+
+    // Mask pattern: every pattern repeats every 6 columns
+    qrtiny_row_t period = 0, mask = 0;
+    for (int x = 0; x < 6; x++) period |= (qrtiny_row_t)QrTinyCalculateMask(formatInfo, x, y) << x;
+    for (int x = 0; x < QRTINY_DIMENSION; x += 6) mask |= period << x;
+
+    // Data modules
+    qrtiny_row_t data = all & ~function;
+    qrtiny_row_t row = 0;
+    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(formatInfo);
+    for (int x = 0; x < QRTINY_DIMENSION; x++)
+    {
+        if (!((data >> x) & 1)) continue;
+        size_t index = QrTinyIdentifyIndex(x, y);
+        if ((QRTINY_TOTAL_CAPACITY & 7) == 0 || (index >> 3) < QRTINY_TOTAL_CAPACITY / 8)    // Not a remainder bit
+        {
+            row |= (qrtiny_row_t)((buffer[QrTinyCodewordIndex(index >> 3, errorCorrectionLevel)] >> (index & 7)) & 1) << x;
+        }
+    }
+    row = ((row ^ mask) & data) | dark;
+    return (qrtiny_quiet_row_t)row << quiet;
+}
+
+// --- Fast mode: whole-symbol rendering from precomputed tables ---
+// The tables for the version, with bit x of row y for each module:
+//   qrtinyFunctionRows:      dark function modules (finders, timing, alignment and the always-dark module; format info is added separately)
+//   qrtinyFunctionMaskRows:  function modules (excluding format info)
+//   qrtinyMaskRows:          mask patterns (0b000 to 0b111), restricted to the data modules
+//   qrtinyFormatModules:     module coordinates (x, y) of both copies of each format info bit
+//   qrtinyPlacement:         module coordinates (x, y) of each data bit, in the bit index order of QrTinyIdentifyIndex() (codeword * 8 + bit,
+//                            least-significant first), for the codewords in the order placed
+// and, for the versions with an alignment pattern:
+//   qrtinyDataRows:          data modules (including remainder bits)
+//   qrtinyColumnPairOffsets: count of the data modules to the right of each two-module column (from the right)
+#if QRTINY_VERSION == 1
+static const qrtiny_row_t qrtinyFunctionRows[QRTINY_DIMENSION] = {
+    0x1fc07f, 0x104041, 0x17405d, 0x17405d, 0x17405d, 0x104041, 0x1fd57f,
+    0x000000, 0x000040, 0x000000, 0x000040, 0x000000, 0x000040, 0x000100,
+    0x00007f, 0x000041, 0x00005d, 0x00005d, 0x00005d, 0x000041, 0x00007f,
+};
+
+static const qrtiny_row_t qrtinyFunctionMaskRows[QRTINY_DIMENSION] = {
+    0x1fe0ff, 0x1fe0ff, 0x1fe0ff, 0x1fe0ff, 0x1fe0ff, 0x1fe0ff, 0x1fffff,
+    0x1fe0ff, 0x000040, 0x000040, 0x000040, 0x000040, 0x000040, 0x0001ff,
+    0x0000ff, 0x0000ff, 0x0000ff, 0x0000ff, 0x0000ff, 0x0000ff, 0x0000ff,
+};
+
+static const qrtiny_row_t qrtinyMaskRows[1 << QRTINY_SIZE_MASK][QRTINY_DIMENSION] = {
+    { 0x001400, 0x000a00, 0x001400, 0x000a00, 0x001400, 0x000a00, 0x000000, 0x000a00, 0x001400, 0x0aaaaa, 0x155515, 0x0aaaaa, 0x155515, 0x0aaa00, 0x155400, 0x0aaa00, 0x155400, 0x0aaa00, 0x155400, 0x0aaa00, 0x155400 }, // 0b000
+    { 0x001e00, 0x000000, 0x001e00, 0x000000, 0x001e00, 0x000000, 0x000000, 0x000000, 0x001e00, 0x000000, 0x1fffbf, 0x000000, 0x1fffbf, 0x000000, 0x1ffe00, 0x000000, 0x1ffe00, 0x000000, 0x1ffe00, 0x000000, 0x1ffe00 }, // 0b001
+    { 0x001200, 0x001200, 0x001200, 0x001200, 0x001200, 0x001200, 0x000000, 0x001200, 0x001200, 0x049209, 0x049209, 0x049209, 0x049209, 0x049200, 0x049200, 0x049200, 0x049200, 0x049200, 0x049200, 0x049200, 0x049200 }, // 0b010
+    { 0x001200, 0x000800, 0x000400, 0x001200, 0x000800, 0x000400, 0x000000, 0x000800, 0x000400, 0x049209, 0x124924, 0x092492, 0x049209, 0x124800, 0x092400, 0x049200, 0x124800, 0x092400, 0x049200, 0x124800, 0x092400 }, // 0b011
+    { 0x001000, 0x001000, 0x000e00, 0x000e00, 0x001000, 0x001000, 0x000000, 0x000e00, 0x001000, 0x1c7187, 0x038e38, 0x038e38, 0x1c7187, 0x1c7000, 0x038e00, 0x038e00, 0x1c7000, 0x1c7000, 0x038e00, 0x038e00, 0x1c7000 }, // 0b100
+    { 0x001e00, 0x001000, 0x001200, 0x001400, 0x001200, 0x001000, 0x000000, 0x001000, 0x001200, 0x155515, 0x049209, 0x041001, 0x1fffbf, 0x041000, 0x049200, 0x155400, 0x049200, 0x041000, 0x1ffe00, 0x041000, 0x049200 }, // 0b101
+    { 0x001e00, 0x001000, 0x001600, 0x001400, 0x001a00, 0x001c00, 0x000000, 0x001000, 0x001600, 0x155515, 0x16db2d, 0x071c31, 0x1fffbf, 0x1c7000, 0x0db600, 0x155400, 0x16da00, 0x071c00, 0x1ffe00, 0x1c7000, 0x0db600 }, // 0b110
+    { 0x001400, 0x000e00, 0x001c00, 0x000a00, 0x001000, 0x000200, 0x000000, 0x000e00, 0x001c00, 0x0aaaaa, 0x1c7187, 0x18e38e, 0x155515, 0x038e00, 0x071c00, 0x0aaa00, 0x1c7000, 0x18e200, 0x155400, 0x038e00, 0x071c00 }, // 0b111
+};
+
+static const uint8_t qrtinyFormatModules[QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH][2][2] = {
+    { { 8, 0 }, { 20, 8 } },
+    { { 8, 1 }, { 19, 8 } },
+    { { 8, 2 }, { 18, 8 } },
+    { { 8, 3 }, { 17, 8 } },
+    { { 8, 4 }, { 16, 8 } },
+    { { 8, 5 }, { 15, 8 } },
+    { { 8, 7 }, { 14, 8 } },
+    { { 8, 8 }, { 13, 8 } },
+    { { 7, 8 }, { 8, 14 } },
+    { { 5, 8 }, { 8, 15 } },
+    { { 4, 8 }, { 8, 16 } },
+    { { 3, 8 }, { 8, 17 } },
+    { { 2, 8 }, { 8, 18 } },
+    { { 1, 8 }, { 8, 19 } },
+    { { 0, 8 }, { 8, 20 } },
+};
+
+static const uint8_t qrtinyPlacement[QRTINY_TOTAL_CAPACITY / 8 * 8][2] = {
+    { 19, 17 }, { 20, 17 }, { 19, 18 }, { 20, 18 }, { 19, 19 }, { 20, 19 }, { 19, 20 }, { 20, 20 },
+    { 19, 13 }, { 20, 13 }, { 19, 14 }, { 20, 14 }, { 19, 15 }, { 20, 15 }, { 19, 16 }, { 20, 16 },
+    { 19, 9 }, { 20, 9 }, { 19, 10 }, { 20, 10 }, { 19, 11 }, { 20, 11 }, { 19, 12 }, { 20, 12 },
+    { 17, 12 }, { 18, 12 }, { 17, 11 }, { 18, 11 }, { 17, 10 }, { 18, 10 }, { 17, 9 }, { 18, 9 },
+    { 17, 16 }, { 18, 16 }, { 17, 15 }, { 18, 15 }, { 17, 14 }, { 18, 14 }, { 17, 13 }, { 18, 13 },
+    { 17, 20 }, { 18, 20 }, { 17, 19 }, { 18, 19 }, { 17, 18 }, { 18, 18 }, { 17, 17 }, { 18, 17 },
+    { 15, 17 }, { 16, 17 }, { 15, 18 }, { 16, 18 }, { 15, 19 }, { 16, 19 }, { 15, 20 }, { 16, 20 },
+    { 15, 13 }, { 16, 13 }, { 15, 14 }, { 16, 14 }, { 15, 15 }, { 16, 15 }, { 15, 16 }, { 16, 16 },
+    { 15, 9 }, { 16, 9 }, { 15, 10 }, { 16, 10 }, { 15, 11 }, { 16, 11 }, { 15, 12 }, { 16, 12 },
+    { 13, 12 }, { 14, 12 }, { 13, 11 }, { 14, 11 }, { 13, 10 }, { 14, 10 }, { 13, 9 }, { 14, 9 },
+    { 13, 16 }, { 14, 16 }, { 13, 15 }, { 14, 15 }, { 13, 14 }, { 14, 14 }, { 13, 13 }, { 14, 13 },
+    { 13, 20 }, { 14, 20 }, { 13, 19 }, { 14, 19 }, { 13, 18 }, { 14, 18 }, { 13, 17 }, { 14, 17 },
+    { 11, 17 }, { 12, 17 }, { 11, 18 }, { 12, 18 }, { 11, 19 }, { 12, 19 }, { 11, 20 }, { 12, 20 },
+    { 11, 13 }, { 12, 13 }, { 11, 14 }, { 12, 14 }, { 11, 15 }, { 12, 15 }, { 11, 16 }, { 12, 16 },
+    { 11, 9 }, { 12, 9 }, { 11, 10 }, { 12, 10 }, { 11, 11 }, { 12, 11 }, { 11, 12 }, { 12, 12 },
+    { 11, 4 }, { 12, 4 }, { 11, 5 }, { 12, 5 }, { 11, 7 }, { 12, 7 }, { 11, 8 }, { 12, 8 },
+    { 11, 0 }, { 12, 0 }, { 11, 1 }, { 12, 1 }, { 11, 2 }, { 12, 2 }, { 11, 3 }, { 12, 3 },
+    { 9, 3 }, { 10, 3 }, { 9, 2 }, { 10, 2 }, { 9, 1 }, { 10, 1 }, { 9, 0 }, { 10, 0 },
+    { 9, 8 }, { 10, 8 }, { 9, 7 }, { 10, 7 }, { 9, 5 }, { 10, 5 }, { 9, 4 }, { 10, 4 },
+    { 9, 12 }, { 10, 12 }, { 9, 11 }, { 10, 11 }, { 9, 10 }, { 10, 10 }, { 9, 9 }, { 10, 9 },
+    { 9, 16 }, { 10, 16 }, { 9, 15 }, { 10, 15 }, { 9, 14 }, { 10, 14 }, { 9, 13 }, { 10, 13 },
+    { 9, 20 }, { 10, 20 }, { 9, 19 }, { 10, 19 }, { 9, 18 }, { 10, 18 }, { 9, 17 }, { 10, 17 },
+    { 7, 9 }, { 8, 9 }, { 7, 10 }, { 8, 10 }, { 7, 11 }, { 8, 11 }, { 7, 12 }, { 8, 12 },
+    { 4, 12 }, { 5, 12 }, { 4, 11 }, { 5, 11 }, { 4, 10 }, { 5, 10 }, { 4, 9 }, { 5, 9 },
+    { 2, 9 }, { 3, 9 }, { 2, 10 }, { 3, 10 }, { 2, 11 }, { 3, 11 }, { 2, 12 }, { 3, 12 },
+    { 0, 12 }, { 1, 12 }, { 0, 11 }, { 1, 11 }, { 0, 10 }, { 1, 10 }, { 0, 9 }, { 1, 9 },
+};
+#elif QRTINY_VERSION == 2
+static const qrtiny_row_t qrtinyFunctionRows[QRTINY_DIMENSION] = {
+    0x1fc007f, 0x1040041, 0x174005d, 0x174005d, 0x174005d,
+    0x1040041, 0x1fd557f, 0x0000000, 0x0000040, 0x0000000,
+    0x0000040, 0x0000000, 0x0000040, 0x0000000, 0x0000040,
+    0x0000000, 0x01f0040, 0x0110100, 0x015007f, 0x0110041,
+    0x01f005d, 0x000005d, 0x000005d, 0x0000041, 0x000007f,
+};
+
+static const qrtiny_row_t qrtinyFunctionMaskRows[QRTINY_DIMENSION] = {
+    0x1fe00ff, 0x1fe00ff, 0x1fe00ff, 0x1fe00ff, 0x1fe00ff,
+    0x1fe00ff, 0x1ffffff, 0x1fe00ff, 0x0000040, 0x0000040,
+    0x0000040, 0x0000040, 0x0000040, 0x0000040, 0x0000040,
+    0x0000040, 0x01f0040, 0x01f01ff, 0x01f00ff, 0x01f00ff,
+    0x01f00ff, 0x00000ff, 0x00000ff, 0x00000ff, 0x00000ff,
+};
+
+static const qrtiny_row_t qrtinyDataRows[QRTINY_DIMENSION] = {
+    0x001fe00, 0x001fe00, 0x001fe00, 0x001fe00, 0x001fe00,
+    0x001fe00, 0x0000000, 0x001fe00, 0x001fe00, 0x1ffffbf,
+    0x1ffffbf, 0x1ffffbf, 0x1ffffbf, 0x1ffffbf, 0x1ffffbf,
+    0x1ffffbf, 0x1e0ffbf, 0x1e0fe00, 0x1e0fe00, 0x1e0fe00,
+    0x1e0fe00, 0x1fffe00, 0x1fffe00, 0x1fffe00, 0x1fffe00,
+};
+
+static const qrtiny_row_t qrtinyMaskRows[1 << QRTINY_SIZE_MASK][QRTINY_DIMENSION] = {
+    { 0x0015400, 0x000aa00, 0x0015400, 0x000aa00, 0x0015400, 0x000aa00, 0x0000000, 0x000aa00, 0x0015400, 0x0aaaaaa, 0x1555515, 0x0aaaaaa, 0x1555515, 0x0aaaaaa, 0x1555515, 0x0aaaaaa, 0x1405515, 0x0a0aa00, 0x1405400, 0x0a0aa00, 0x1405400, 0x0aaaa00, 0x1555400, 0x0aaaa00, 0x1555400 }, // 0b000
+    { 0x001fe00, 0x0000000, 0x001fe00, 0x0000000, 0x001fe00, 0x0000000, 0x0000000, 0x0000000, 0x001fe00, 0x0000000, 0x1ffffbf, 0x0000000, 0x1ffffbf, 0x0000000, 0x1ffffbf, 0x0000000, 0x1e0ffbf, 0x0000000, 0x1e0fe00, 0x0000000, 0x1e0fe00, 0x0000000, 0x1fffe00, 0x0000000, 0x1fffe00 }, // 0b001
+    { 0x0009200, 0x0009200, 0x0009200, 0x0009200, 0x0009200, 0x0009200, 0x0000000, 0x0009200, 0x0009200, 0x1249209, 0x1249209, 0x1249209, 0x1249209, 0x1249209, 0x1249209, 0x1249209, 0x1209209, 0x1209200, 0x1209200, 0x1209200, 0x1209200, 0x1249200, 0x1249200, 0x1249200, 0x1249200 }, // 0b010
+    { 0x0009200, 0x0004800, 0x0012400, 0x0009200, 0x0004800, 0x0012400, 0x0000000, 0x0004800, 0x0012400, 0x1249209, 0x0924924, 0x0492492, 0x1249209, 0x0924924, 0x0492492, 0x1249209, 0x0804924, 0x0402400, 0x1209200, 0x0804800, 0x0402400, 0x1249200, 0x0924800, 0x0492400, 0x1249200 }, // 0b011
+    { 0x0007000, 0x0007000, 0x0018e00, 0x0018e00, 0x0007000, 0x0007000, 0x0000000, 0x0018e00, 0x0007000, 0x11c7187, 0x0e38e38, 0x0e38e38, 0x11c7187, 0x11c7187, 0x0e38e38, 0x0e38e38, 0x1007187, 0x1007000, 0x0e08e00, 0x0e08e00, 0x1007000, 0x11c7000, 0x0e38e00, 0x0e38e00, 0x11c7000 }, // 0b100
+    { 0x001fe00, 0x0001000, 0x0009200, 0x0015400, 0x0009200, 0x0001000, 0x0000000, 0x0001000, 0x0009200, 0x1555515, 0x1249209, 0x1041001, 0x1ffffbf, 0x1041001, 0x1249209, 0x1555515, 0x1209209, 0x1001000, 0x1e0fe00, 0x1001000, 0x1209200, 0x1555400, 0x1249200, 0x1041000, 0x1fffe00 }, // 0b101
+    { 0x001fe00, 0x0007000, 0x001b600, 0x0015400, 0x000da00, 0x0011c00, 0x0000000, 0x0007000, 0x001b600, 0x1555515, 0x1b6db2d, 0x1c71c31, 0x1ffffbf, 0x11c7187, 0x16db69b, 0x1555515, 0x1a0db2d, 0x1c01c00, 0x1e0fe00, 0x1007000, 0x160b600, 0x1555400, 0x1b6da00, 0x1c71c00, 0x1fffe00 }, // 0b110
+    { 0x0015400, 0x0018e00, 0x0011c00, 0x000aa00, 0x0007000, 0x000e200, 0x0000000, 0x0018e00, 0x0011c00, 0x0aaaaaa, 0x11c7187, 0x038e38e, 0x1555515, 0x0e38e38, 0x1c71c31, 0x0aaaaaa, 0x1007187, 0x020e200, 0x1405400, 0x0e08e00, 0x1c01c00, 0x0aaaa00, 0x11c7000, 0x038e200, 0x1555400 }, // 0b111
+};
+
+static const uint8_t qrtinyFormatModules[QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH][2][2] = {
+    { { 8, 0 }, { 24, 8 } },
+    { { 8, 1 }, { 23, 8 } },
+    { { 8, 2 }, { 22, 8 } },
+    { { 8, 3 }, { 21, 8 } },
+    { { 8, 4 }, { 20, 8 } },
+    { { 8, 5 }, { 19, 8 } },
+    { { 8, 7 }, { 18, 8 } },
+    { { 8, 8 }, { 17, 8 } },
+    { { 7, 8 }, { 8, 18 } },
+    { { 5, 8 }, { 8, 19 } },
+    { { 4, 8 }, { 8, 20 } },
+    { { 3, 8 }, { 8, 21 } },
+    { { 2, 8 }, { 8, 22 } },
+    { { 1, 8 }, { 8, 23 } },
+    { { 0, 8 }, { 8, 24 } },
+};
+
+static const uint16_t qrtinyColumnPairOffsets[(QRTINY_DIMENSION - 1) / 2] = {
+    0, 32, 64, 86, 108, 151, 199, 247, 295, 311, 327, 343,
+};
+
+static const uint8_t qrtinyPlacement[QRTINY_TOTAL_CAPACITY / 8 * 8][2] = {
+    { 23, 21 }, { 24, 21 }, { 23, 22 }, { 24, 22 }, { 23, 23 }, { 24, 23 }, { 23, 24 }, { 24, 24 },
+    { 23, 17 }, { 24, 17 }, { 23, 18 }, { 24, 18 }, { 23, 19 }, { 24, 19 }, { 23, 20 }, { 24, 20 },
+    { 23, 13 }, { 24, 13 }, { 23, 14 }, { 24, 14 }, { 23, 15 }, { 24, 15 }, { 23, 16 }, { 24, 16 },
+    { 23, 9 }, { 24, 9 }, { 23, 10 }, { 24, 10 }, { 23, 11 }, { 24, 11 }, { 23, 12 }, { 24, 12 },
+    { 21, 12 }, { 22, 12 }, { 21, 11 }, { 22, 11 }, { 21, 10 }, { 22, 10 }, { 21, 9 }, { 22, 9 },
+    { 21, 16 }, { 22, 16 }, { 21, 15 }, { 22, 15 }, { 21, 14 }, { 22, 14 }, { 21, 13 }, { 22, 13 },
+    { 21, 20 }, { 22, 20 }, { 21, 19 }, { 22, 19 }, { 21, 18 }, { 22, 18 }, { 21, 17 }, { 22, 17 },
+    { 21, 24 }, { 22, 24 }, { 21, 23 }, { 22, 23 }, { 21, 22 }, { 22, 22 }, { 21, 21 }, { 22, 21 },
+    { 19, 21 }, { 20, 21 }, { 19, 22 }, { 20, 22 }, { 19, 23 }, { 20, 23 }, { 19, 24 }, { 20, 24 },
+    { 19, 12 }, { 20, 12 }, { 19, 13 }, { 20, 13 }, { 19, 14 }, { 20, 14 }, { 19, 15 }, { 20, 15 },
+    { 17, 9 }, { 18, 9 }, { 19, 9 }, { 20, 9 }, { 19, 10 }, { 20, 10 }, { 19, 11 }, { 20, 11 },
+    { 17, 13 }, { 18, 13 }, { 17, 12 }, { 18, 12 }, { 17, 11 }, { 18, 11 }, { 17, 10 }, { 18, 10 },
+    { 17, 22 }, { 18, 22 }, { 17, 21 }, { 18, 21 }, { 17, 15 }, { 18, 15 }, { 17, 14 }, { 18, 14 },
+    { 15, 23 }, { 16, 23 }, { 15, 24 }, { 16, 24 }, { 17, 24 }, { 18, 24 }, { 17, 23 }, { 18, 23 },
+    { 15, 17 }, { 15, 18 }, { 15, 19 }, { 15, 20 }, { 15, 21 }, { 16, 21 }, { 15, 22 }, { 16, 22 },
+    { 16, 12 }, { 15, 13 }, { 16, 13 }, { 15, 14 }, { 16, 14 }, { 15, 15 }, { 16, 15 }, { 15, 16 },
+    { 16, 8 }, { 15, 9 }, { 16, 9 }, { 15, 10 }, { 16, 10 }, { 15, 11 }, { 16, 11 }, { 15, 12 },
+    { 16, 3 }, { 15, 4 }, { 16, 4 }, { 15, 5 }, { 16, 5 }, { 15, 7 }, { 16, 7 }, { 15, 8 },
+    { 14, 0 }, { 15, 0 }, { 16, 0 }, { 15, 1 }, { 16, 1 }, { 15, 2 }, { 16, 2 }, { 15, 3 },
+    { 14, 4 }, { 13, 3 }, { 14, 3 }, { 13, 2 }, { 14, 2 }, { 13, 1 }, { 14, 1 }, { 13, 0 },
+    { 14, 9 }, { 13, 8 }, { 14, 8 }, { 13, 7 }, { 14, 7 }, { 13, 5 }, { 14, 5 }, { 13, 4 },
+    { 14, 13 }, { 13, 12 }, { 14, 12 }, { 13, 11 }, { 14, 11 }, { 13, 10 }, { 14, 10 }, { 13, 9 },
+    { 14, 17 }, { 13, 16 }, { 14, 16 }, { 13, 15 }, { 14, 15 }, { 13, 14 }, { 14, 14 }, { 13, 13 },
+    { 14, 21 }, { 13, 20 }, { 14, 20 }, { 13, 19 }, { 14, 19 }, { 13, 18 }, { 14, 18 }, { 13, 17 },
+    { 12, 24 }, { 13, 24 }, { 14, 24 }, { 13, 23 }, { 14, 23 }, { 13, 22 }, { 14, 22 }, { 13, 21 },
+    { 12, 20 }, { 11, 21 }, { 12, 21 }, { 11, 22 }, { 12, 22 }, { 11, 23 }, { 12, 23 }, { 11, 24 },
+    { 12, 16 }, { 11, 17 }, { 12, 17 }, { 11, 18 }, { 12, 18 }, { 11, 19 }, { 12, 19 }, { 11, 20 },
+    { 12, 12 }, { 11, 13 }, { 12, 13 }, { 11, 14 }, { 12, 14 }, { 11, 15 }, { 12, 15 }, { 11, 16 },
+    { 12, 8 }, { 11, 9 }, { 12, 9 }, { 11, 10 }, { 12, 10 }, { 11, 11 }, { 12, 11 }, { 11, 12 },
+    { 12, 3 }, { 11, 4 }, { 12, 4 }, { 11, 5 }, { 12, 5 }, { 11, 7 }, { 12, 7 }, { 11, 8 },
+    { 10, 0 }, { 11, 0 }, { 12, 0 }, { 11, 1 }, { 12, 1 }, { 11, 2 }, { 12, 2 }, { 11, 3 },
+    { 10, 4 }, { 9, 3 }, { 10, 3 }, { 9, 2 }, { 10, 2 }, { 9, 1 }, { 10, 1 }, { 9, 0 },
+    { 10, 9 }, { 9, 8 }, { 10, 8 }, { 9, 7 }, { 10, 7 }, { 9, 5 }, { 10, 5 }, { 9, 4 },
+    { 10, 13 }, { 9, 12 }, { 10, 12 }, { 9, 11 }, { 10, 11 }, { 9, 10 }, { 10, 10 }, { 9, 9 },
+    { 10, 17 }, { 9, 16 }, { 10, 16 }, { 9, 15 }, { 10, 15 }, { 9, 14 }, { 10, 14 }, { 9, 13 },
+    { 10, 21 }, { 9, 20 }, { 10, 20 }, { 9, 19 }, { 10, 19 }, { 9, 18 }, { 10, 18 }, { 9, 17 },
+    { 8, 16 }, { 9, 24 }, { 10, 24 }, { 9, 23 }, { 10, 23 }, { 9, 22 }, { 10, 22 }, { 9, 21 },
+    { 8, 12 }, { 7, 13 }, { 8, 13 }, { 7, 14 }, { 8, 14 }, { 7, 15 }, { 8, 15 }, { 7, 16 },
+    { 5, 9 }, { 7, 9 }, { 8, 9 }, { 7, 10 }, { 8, 10 }, { 7, 11 }, { 8, 11 }, { 7, 12 },
+    { 5, 13 }, { 4, 12 }, { 5, 12 }, { 4, 11 }, { 5, 11 }, { 4, 10 }, { 5, 10 }, { 4, 9 },
+    { 3, 16 }, { 4, 16 }, { 5, 16 }, { 4, 15 }, { 5, 15 }, { 4, 14 }, { 5, 14 }, { 4, 13 },
+    { 3, 12 }, { 2, 13 }, { 3, 13 }, { 2, 14 }, { 3, 14 }, { 2, 15 }, { 3, 15 }, { 2, 16 },
+    { 1, 9 }, { 2, 9 }, { 3, 9 }, { 2, 10 }, { 3, 10 }, { 2, 11 }, { 3, 11 }, { 2, 12 },
+    { 1, 13 }, { 0, 12 }, { 1, 12 }, { 0, 11 }, { 1, 11 }, { 0, 10 }, { 1, 10 }, { 0, 9 },
+};
+#elif QRTINY_VERSION == 3
+static const qrtiny_row_t qrtinyFunctionRows[QRTINY_DIMENSION] = {
+    0x1fc0007f, 0x10400041, 0x1740005d, 0x1740005d, 0x1740005d,
+    0x10400041, 0x1fd5557f, 0x00000000, 0x00000040, 0x00000000,
+    0x00000040, 0x00000000, 0x00000040, 0x00000000, 0x00000040,
+    0x00000000, 0x00000040, 0x00000000, 0x00000040, 0x00000000,
+    0x01f00040, 0x01100100, 0x0150007f, 0x01100041, 0x01f0005d,
+    0x0000005d, 0x0000005d, 0x00000041, 0x0000007f,
+};
+
+static const qrtiny_row_t qrtinyFunctionMaskRows[QRTINY_DIMENSION] = {
+    0x1fe000ff, 0x1fe000ff, 0x1fe000ff, 0x1fe000ff, 0x1fe000ff,
+    0x1fe000ff, 0x1fffffff, 0x1fe000ff, 0x00000040, 0x00000040,
+    0x00000040, 0x00000040, 0x00000040, 0x00000040, 0x00000040,
+    0x00000040, 0x00000040, 0x00000040, 0x00000040, 0x00000040,
+    0x01f00040, 0x01f001ff, 0x01f000ff, 0x01f000ff, 0x01f000ff,
+    0x000000ff, 0x000000ff, 0x000000ff, 0x000000ff,
+};
+
+static const qrtiny_row_t qrtinyDataRows[QRTINY_DIMENSION] = {
+    0x001ffe00, 0x001ffe00, 0x001ffe00, 0x001ffe00, 0x001ffe00,
+    0x001ffe00, 0x00000000, 0x001ffe00, 0x001ffe00, 0x1fffffbf,
+    0x1fffffbf, 0x1fffffbf, 0x1fffffbf, 0x1fffffbf, 0x1fffffbf,
+    0x1fffffbf, 0x1fffffbf, 0x1fffffbf, 0x1fffffbf, 0x1fffffbf,
+    0x1e0fffbf, 0x1e0ffe00, 0x1e0ffe00, 0x1e0ffe00, 0x1e0ffe00,
+    0x1ffffe00, 0x1ffffe00, 0x1ffffe00, 0x1ffffe00,
+};
+
+static const qrtiny_row_t qrtinyMaskRows[1 << QRTINY_SIZE_MASK][QRTINY_DIMENSION] = {
+    { 0x00155400, 0x000aaa00, 0x00155400, 0x000aaa00, 0x00155400, 0x000aaa00, 0x00000000, 0x000aaa00, 0x00155400, 0x0aaaaaaa, 0x15555515, 0x0aaaaaaa, 0x15555515, 0x0aaaaaaa, 0x15555515, 0x0aaaaaaa, 0x15555515, 0x0aaaaaaa, 0x15555515, 0x0aaaaaaa, 0x14055515, 0x0a0aaa00, 0x14055400, 0x0a0aaa00, 0x14055400, 0x0aaaaa00, 0x15555400, 0x0aaaaa00, 0x15555400 }, // 0b000
+    { 0x001ffe00, 0x00000000, 0x001ffe00, 0x00000000, 0x001ffe00, 0x00000000, 0x00000000, 0x00000000, 0x001ffe00, 0x00000000, 0x1fffffbf, 0x00000000, 0x1fffffbf, 0x00000000, 0x1fffffbf, 0x00000000, 0x1fffffbf, 0x00000000, 0x1fffffbf, 0x00000000, 0x1e0fffbf, 0x00000000, 0x1e0ffe00, 0x00000000, 0x1e0ffe00, 0x00000000, 0x1ffffe00, 0x00000000, 0x1ffffe00 }, // 0b001
+    { 0x00049200, 0x00049200, 0x00049200, 0x00049200, 0x00049200, 0x00049200, 0x00000000, 0x00049200, 0x00049200, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x09249209, 0x08049209, 0x08049200, 0x08049200, 0x08049200, 0x08049200, 0x09249200, 0x09249200, 0x09249200, 0x09249200 }, // 0b010
+    { 0x00049200, 0x00124800, 0x00092400, 0x00049200, 0x00124800, 0x00092400, 0x00000000, 0x00124800, 0x00092400, 0x09249209, 0x04924924, 0x12492492, 0x09249209, 0x04924924, 0x12492492, 0x09249209, 0x04924924, 0x12492492, 0x09249209, 0x04924924, 0x12092492, 0x08049200, 0x04024800, 0x12092400, 0x08049200, 0x04924800, 0x12492400, 0x09249200, 0x04924800 }, // 0b011
+    { 0x001c7000, 0x001c7000, 0x00038e00, 0x00038e00, 0x001c7000, 0x001c7000, 0x00000000, 0x00038e00, 0x001c7000, 0x071c7187, 0x18e38e38, 0x18e38e38, 0x071c7187, 0x071c7187, 0x18e38e38, 0x18e38e38, 0x071c7187, 0x071c7187, 0x18e38e38, 0x18e38e38, 0x060c7187, 0x060c7000, 0x18038e00, 0x18038e00, 0x060c7000, 0x071c7000, 0x18e38e00, 0x18e38e00, 0x071c7000 }, // 0b100
+    { 0x001ffe00, 0x00041000, 0x00049200, 0x00155400, 0x00049200, 0x00041000, 0x00000000, 0x00041000, 0x00049200, 0x15555515, 0x09249209, 0x01041001, 0x1fffffbf, 0x01041001, 0x09249209, 0x15555515, 0x09249209, 0x01041001, 0x1fffffbf, 0x01041001, 0x08049209, 0x14055400, 0x08049200, 0x00041000, 0x1e0ffe00, 0x01041000, 0x09249200, 0x15555400, 0x09249200 }, // 0b101
+    { 0x001ffe00, 0x001c7000, 0x000db600, 0x00155400, 0x0016da00, 0x00071c00, 0x00000000, 0x001c7000, 0x000db600, 0x15555515, 0x0db6db2d, 0x11c71c31, 0x1fffffbf, 0x071c7187, 0x1b6db69b, 0x15555515, 0x0db6db2d, 0x11c71c31, 0x1fffffbf, 0x071c7187, 0x1a0db69b, 0x14055400, 0x0c06da00, 0x10071c00, 0x1e0ffe00, 0x071c7000, 0x1b6db600, 0x15555400, 0x0db6da00 }, // 0b110
+    { 0x00155400, 0x00038e00, 0x00071c00, 0x000aaa00, 0x001c7000, 0x0018e200, 0x00000000, 0x00038e00, 0x00071c00, 0x0aaaaaaa, 0x071c7187, 0x0e38e38e, 0x15555515, 0x18e38e38, 0x11c71c31, 0x0aaaaaaa, 0x071c7187, 0x0e38e38e, 0x15555515, 0x18e38e38, 0x10071c31, 0x0a0aaa00, 0x060c7000, 0x0e08e200, 0x14055400, 0x18e38e00, 0x11c71c00, 0x0aaaaa00, 0x071c7000 }, // 0b111
+};
+
+static const uint8_t qrtinyFormatModules[QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH][2][2] = {
+    { { 8, 0 }, { 28, 8 } },
+    { { 8, 1 }, { 27, 8 } },
+    { { 8, 2 }, { 26, 8 } },
+    { { 8, 3 }, { 25, 8 } },
+    { { 8, 4 }, { 24, 8 } },
+    { { 8, 5 }, { 23, 8 } },
+    { { 8, 7 }, { 22, 8 } },
+    { { 8, 8 }, { 21, 8 } },
+    { { 7, 8 }, { 8, 22 } },
+    { { 5, 8 }, { 8, 23 } },
+    { { 4, 8 }, { 8, 24 } },
+    { { 3, 8 }, { 8, 25 } },
+    { { 2, 8 }, { 8, 26 } },
+    { { 1, 8 }, { 8, 27 } },
+    { { 0, 8 }, { 8, 28 } },
+};
+
+static const uint16_t qrtinyColumnPairOffsets[(QRTINY_DIMENSION - 1) / 2] = {
+    0, 40, 80, 110, 140, 191, 247, 303, 359, 415, 471, 495, 519, 543,
+};
+
+static const uint8_t qrtinyPlacement[QRTINY_TOTAL_CAPACITY / 8 * 8][2] = {
+    { 27, 25 }, { 28, 25 }, { 27, 26 }, { 28, 26 }, { 27, 27 }, { 28, 27 }, { 27, 28 }, { 28, 28 },
+    { 27, 21 }, { 28, 21 }, { 27, 22 }, { 28, 22 }, { 27, 23 }, { 28, 23 }, { 27, 24 }, { 28, 24 },
+    { 27, 17 }, { 28, 17 }, { 27, 18 }, { 28, 18 }, { 27, 19 }, { 28, 19 }, { 27, 20 }, { 28, 20 },
+    { 27, 13 }, { 28, 13 }, { 27, 14 }, { 28, 14 }, { 27, 15 }, { 28, 15 }, { 27, 16 }, { 28, 16 },
+    { 27, 9 }, { 28, 9 }, { 27, 10 }, { 28, 10 }, { 27, 11 }, { 28, 11 }, { 27, 12 }, { 28, 12 },
+    { 25, 12 }, { 26, 12 }, { 25, 11 }, { 26, 11 }, { 25, 10 }, { 26, 10 }, { 25, 9 }, { 26, 9 },
+    { 25, 16 }, { 26, 16 }, { 25, 15 }, { 26, 15 }, { 25, 14 }, { 26, 14 }, { 25, 13 }, { 26, 13 },
+    { 25, 20 }, { 26, 20 }, { 25, 19 }, { 26, 19 }, { 25, 18 }, { 26, 18 }, { 25, 17 }, { 26, 17 },
+    { 25, 24 }, { 26, 24 }, { 25, 23 }, { 26, 23 }, { 25, 22 }, { 26, 22 }, { 25, 21 }, { 26, 21 },
+    { 25, 28 }, { 26, 28 }, { 25, 27 }, { 26, 27 }, { 25, 26 }, { 26, 26 }, { 25, 25 }, { 26, 25 },
+    { 23, 25 }, { 24, 25 }, { 23, 26 }, { 24, 26 }, { 23, 27 }, { 24, 27 }, { 23, 28 }, { 24, 28 },
+    { 23, 16 }, { 24, 16 }, { 23, 17 }, { 24, 17 }, { 23, 18 }, { 24, 18 }, { 23, 19 }, { 24, 19 },
+    { 23, 12 }, { 24, 12 }, { 23, 13 }, { 24, 13 }, { 23, 14 }, { 24, 14 }, { 23, 15 }, { 24, 15 },
+    { 21, 9 }, { 22, 9 }, { 23, 9 }, { 24, 9 }, { 23, 10 }, { 24, 10 }, { 23, 11 }, { 24, 11 },
+    { 21, 13 }, { 22, 13 }, { 21, 12 }, { 22, 12 }, { 21, 11 }, { 22, 11 }, { 21, 10 }, { 22, 10 },
+    { 21, 17 }, { 22, 17 }, { 21, 16 }, { 22, 16 }, { 21, 15 }, { 22, 15 }, { 21, 14 }, { 22, 14 },
+    { 21, 26 }, { 22, 26 }, { 21, 25 }, { 22, 25 }, { 21, 19 }, { 22, 19 }, { 21, 18 }, { 22, 18 },
+    { 19, 27 }, { 20, 27 }, { 19, 28 }, { 20, 28 }, { 21, 28 }, { 22, 28 }, { 21, 27 }, { 22, 27 },
+    { 19, 21 }, { 19, 22 }, { 19, 23 }, { 19, 24 }, { 19, 25 }, { 20, 25 }, { 19, 26 }, { 20, 26 },
+    { 20, 16 }, { 19, 17 }, { 20, 17 }, { 19, 18 }, { 20, 18 }, { 19, 19 }, { 20, 19 }, { 19, 20 },
+    { 20, 12 }, { 19, 13 }, { 20, 13 }, { 19, 14 }, { 20, 14 }, { 19, 15 }, { 20, 15 }, { 19, 16 },
+    { 20, 8 }, { 19, 9 }, { 20, 9 }, { 19, 10 }, { 20, 10 }, { 19, 11 }, { 20, 11 }, { 19, 12 },
+    { 20, 3 }, { 19, 4 }, { 20, 4 }, { 19, 5 }, { 20, 5 }, { 19, 7 }, { 20, 7 }, { 19, 8 },
+    { 18, 0 }, { 19, 0 }, { 20, 0 }, { 19, 1 }, { 20, 1 }, { 19, 2 }, { 20, 2 }, { 19, 3 },
+    { 18, 4 }, { 17, 3 }, { 18, 3 }, { 17, 2 }, { 18, 2 }, { 17, 1 }, { 18, 1 }, { 17, 0 },
+    { 18, 9 }, { 17, 8 }, { 18, 8 }, { 17, 7 }, { 18, 7 }, { 17, 5 }, { 18, 5 }, { 17, 4 },
+    { 18, 13 }, { 17, 12 }, { 18, 12 }, { 17, 11 }, { 18, 11 }, { 17, 10 }, { 18, 10 }, { 17, 9 },
+    { 18, 17 }, { 17, 16 }, { 18, 16 }, { 17, 15 }, { 18, 15 }, { 17, 14 }, { 18, 14 }, { 17, 13 },
+    { 18, 21 }, { 17, 20 }, { 18, 20 }, { 17, 19 }, { 18, 19 }, { 17, 18 }, { 18, 18 }, { 17, 17 },
+    { 18, 25 }, { 17, 24 }, { 18, 24 }, { 17, 23 }, { 18, 23 }, { 17, 22 }, { 18, 22 }, { 17, 21 },
+    { 16, 28 }, { 17, 28 }, { 18, 28 }, { 17, 27 }, { 18, 27 }, { 17, 26 }, { 18, 26 }, { 17, 25 },
+    { 16, 24 }, { 15, 25 }, { 16, 25 }, { 15, 26 }, { 16, 26 }, { 15, 27 }, { 16, 27 }, { 15, 28 },
+    { 16, 20 }, { 15, 21 }, { 16, 21 }, { 15, 22 }, { 16, 22 }, { 15, 23 }, { 16, 23 }, { 15, 24 },
+    { 16, 16 }, { 15, 17 }, { 16, 17 }, { 15, 18 }, { 16, 18 }, { 15, 19 }, { 16, 19 }, { 15, 20 },
+    { 16, 12 }, { 15, 13 }, { 16, 13 }, { 15, 14 }, { 16, 14 }, { 15, 15 }, { 16, 15 }, { 15, 16 },
+    { 16, 8 }, { 15, 9 }, { 16, 9 }, { 15, 10 }, { 16, 10 }, { 15, 11 }, { 16, 11 }, { 15, 12 },
+    { 16, 3 }, { 15, 4 }, { 16, 4 }, { 15, 5 }, { 16, 5 }, { 15, 7 }, { 16, 7 }, { 15, 8 },
+    { 14, 0 }, { 15, 0 }, { 16, 0 }, { 15, 1 }, { 16, 1 }, { 15, 2 }, { 16, 2 }, { 15, 3 },
+    { 14, 4 }, { 13, 3 }, { 14, 3 }, { 13, 2 }, { 14, 2 }, { 13, 1 }, { 14, 1 }, { 13, 0 },
+    { 14, 9 }, { 13, 8 }, { 14, 8 }, { 13, 7 }, { 14, 7 }, { 13, 5 }, { 14, 5 }, { 13, 4 },
+    { 14, 13 }, { 13, 12 }, { 14, 12 }, { 13, 11 }, { 14, 11 }, { 13, 10 }, { 14, 10 }, { 13, 9 },
+    { 14, 17 }, { 13, 16 }, { 14, 16 }, { 13, 15 }, { 14, 15 }, { 13, 14 }, { 14, 14 }, { 13, 13 },
+    { 14, 21 }, { 13, 20 }, { 14, 20 }, { 13, 19 }, { 14, 19 }, { 13, 18 }, { 14, 18 }, { 13, 17 },
+    { 14, 25 }, { 13, 24 }, { 14, 24 }, { 13, 23 }, { 14, 23 }, { 13, 22 }, { 14, 22 }, { 13, 21 },
+    { 12, 28 }, { 13, 28 }, { 14, 28 }, { 13, 27 }, { 14, 27 }, { 13, 26 }, { 14, 26 }, { 13, 25 },
+    { 12, 24 }, { 11, 25 }, { 12, 25 }, { 11, 26 }, { 12, 26 }, { 11, 27 }, { 12, 27 }, { 11, 28 },
+    { 12, 20 }, { 11, 21 }, { 12, 21 }, { 11, 22 }, { 12, 22 }, { 11, 23 }, { 12, 23 }, { 11, 24 },
+    { 12, 16 }, { 11, 17 }, { 12, 17 }, { 11, 18 }, { 12, 18 }, { 11, 19 }, { 12, 19 }, { 11, 20 },
+    { 12, 12 }, { 11, 13 }, { 12, 13 }, { 11, 14 }, { 12, 14 }, { 11, 15 }, { 12, 15 }, { 11, 16 },
+    { 12, 8 }, { 11, 9 }, { 12, 9 }, { 11, 10 }, { 12, 10 }, { 11, 11 }, { 12, 11 }, { 11, 12 },
+    { 12, 3 }, { 11, 4 }, { 12, 4 }, { 11, 5 }, { 12, 5 }, { 11, 7 }, { 12, 7 }, { 11, 8 },
+    { 10, 0 }, { 11, 0 }, { 12, 0 }, { 11, 1 }, { 12, 1 }, { 11, 2 }, { 12, 2 }, { 11, 3 },
+    { 10, 4 }, { 9, 3 }, { 10, 3 }, { 9, 2 }, { 10, 2 }, { 9, 1 }, { 10, 1 }, { 9, 0 },
+    { 10, 9 }, { 9, 8 }, { 10, 8 }, { 9, 7 }, { 10, 7 }, { 9, 5 }, { 10, 5 }, { 9, 4 },
+    { 10, 13 }, { 9, 12 }, { 10, 12 }, { 9, 11 }, { 10, 11 }, { 9, 10 }, { 10, 10 }, { 9, 9 },
+    { 10, 17 }, { 9, 16 }, { 10, 16 }, { 9, 15 }, { 10, 15 }, { 9, 14 }, { 10, 14 }, { 9, 13 },
+    { 10, 21 }, { 9, 20 }, { 10, 20 }, { 9, 19 }, { 10, 19 }, { 9, 18 }, { 10, 18 }, { 9, 17 },
+    { 10, 25 }, { 9, 24 }, { 10, 24 }, { 9, 23 }, { 10, 23 }, { 9, 22 }, { 10, 22 }, { 9, 21 },
+    { 8, 20 }, { 9, 28 }, { 10, 28 }, { 9, 27 }, { 10, 27 }, { 9, 26 }, { 10, 26 }, { 9, 25 },
+    { 8, 16 }, { 7, 17 }, { 8, 17 }, { 7, 18 }, { 8, 18 }, { 7, 19 }, { 8, 19 }, { 7, 20 },
+    { 8, 12 }, { 7, 13 }, { 8, 13 }, { 7, 14 }, { 8, 14 }, { 7, 15 }, { 8, 15 }, { 7, 16 },
+    { 5, 9 }, { 7, 9 }, { 8, 9 }, { 7, 10 }, { 8, 10 }, { 7, 11 }, { 8, 11 }, { 7, 12 },
+    { 5, 13 }, { 4, 12 }, { 5, 12 }, { 4, 11 }, { 5, 11 }, { 4, 10 }, { 5, 10 }, { 4, 9 },
+    { 5, 17 }, { 4, 16 }, { 5, 16 }, { 4, 15 }, { 5, 15 }, { 4, 14 }, { 5, 14 }, { 4, 13 },
+    { 3, 20 }, { 4, 20 }, { 5, 20 }, { 4, 19 }, { 5, 19 }, { 4, 18 }, { 5, 18 }, { 4, 17 },
+    { 3, 16 }, { 2, 17 }, { 3, 17 }, { 2, 18 }, { 3, 18 }, { 2, 19 }, { 3, 19 }, { 2, 20 },
+    { 3, 12 }, { 2, 13 }, { 3, 13 }, { 2, 14 }, { 3, 14 }, { 2, 15 }, { 3, 15 }, { 2, 16 },
+    { 1, 9 }, { 2, 9 }, { 3, 9 }, { 2, 10 }, { 3, 10 }, { 2, 11 }, { 3, 11 }, { 2, 12 },
+    { 1, 13 }, { 0, 12 }, { 1, 12 }, { 0, 11 }, { 1, 11 }, { 0, 10 }, { 1, 10 }, { 0, 9 },
+    { 1, 17 }, { 0, 16 }, { 1, 16 }, { 0, 15 }, { 1, 15 }, { 0, 14 }, { 1, 14 }, { 0, 13 },
+};
+#elif QRTINY_VERSION == 4
+static const qrtiny_row_t qrtinyFunctionRows[QRTINY_DIMENSION] = {
+    0x1fc00007f, 0x104000041, 0x17400005d, 0x17400005d, 0x17400005d,
+    0x104000041, 0x1fd55557f, 0x000000000, 0x000000040, 0x000000000,
+    0x000000040, 0x000000000, 0x000000040, 0x000000000, 0x000000040,
+    0x000000000, 0x000000040, 0x000000000, 0x000000040, 0x000000000,
+    0x000000040, 0x000000000, 0x000000040, 0x000000000, 0x01f000040,
+    0x011000100, 0x01500007f, 0x011000041, 0x01f00005d, 0x00000005d,
+    0x00000005d, 0x000000041, 0x00000007f,
+};
+
+static const qrtiny_row_t qrtinyFunctionMaskRows[QRTINY_DIMENSION] = {
+    0x1fe0000ff, 0x1fe0000ff, 0x1fe0000ff, 0x1fe0000ff, 0x1fe0000ff,
+    0x1fe0000ff, 0x1ffffffff, 0x1fe0000ff, 0x000000040, 0x000000040,
+    0x000000040, 0x000000040, 0x000000040, 0x000000040, 0x000000040,
+    0x000000040, 0x000000040, 0x000000040, 0x000000040, 0x000000040,
+    0x000000040, 0x000000040, 0x000000040, 0x000000040, 0x01f000040,
+    0x01f0001ff, 0x01f0000ff, 0x01f0000ff, 0x01f0000ff, 0x0000000ff,
+    0x0000000ff, 0x0000000ff, 0x0000000ff,
+};
+
+static const qrtiny_row_t qrtinyDataRows[QRTINY_DIMENSION] = {
+    0x001fffe00, 0x001fffe00, 0x001fffe00, 0x001fffe00, 0x001fffe00,
+    0x001fffe00, 0x000000000, 0x001fffe00, 0x001fffe00, 0x1ffffffbf,
+    0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf,
+    0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf,
+    0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf, 0x1ffffffbf, 0x1e0ffffbf,
+    0x1e0fffe00, 0x1e0fffe00, 0x1e0fffe00, 0x1e0fffe00, 0x1fffffe00,
+    0x1fffffe00, 0x1fffffe00, 0x1fffffe00,
+};
+
+static const qrtiny_row_t qrtinyMaskRows[1 << QRTINY_SIZE_MASK][QRTINY_DIMENSION] = {
+    { 0x001555400, 0x000aaaa00, 0x001555400, 0x000aaaa00, 0x001555400, 0x000aaaa00, 0x000000000, 0x000aaaa00, 0x001555400, 0x0aaaaaaaa, 0x155555515, 0x0aaaaaaaa, 0x155555515, 0x0aaaaaaaa, 0x155555515, 0x0aaaaaaaa, 0x155555515, 0x0aaaaaaaa, 0x155555515, 0x0aaaaaaaa, 0x155555515, 0x0aaaaaaaa, 0x155555515, 0x0aaaaaaaa, 0x140555515, 0x0a0aaaa00, 0x140555400, 0x0a0aaaa00, 0x140555400, 0x0aaaaaa00, 0x155555400, 0x0aaaaaa00, 0x155555400 }, // 0b000
+    { 0x001fffe00, 0x000000000, 0x001fffe00, 0x000000000, 0x001fffe00, 0x000000000, 0x000000000, 0x000000000, 0x001fffe00, 0x000000000, 0x1ffffffbf, 0x000000000, 0x1ffffffbf, 0x000000000, 0x1ffffffbf, 0x000000000, 0x1ffffffbf, 0x000000000, 0x1ffffffbf, 0x000000000, 0x1ffffffbf, 0x000000000, 0x1ffffffbf, 0x000000000, 0x1e0ffffbf, 0x000000000, 0x1e0fffe00, 0x000000000, 0x1e0fffe00, 0x000000000, 0x1fffffe00, 0x000000000, 0x1fffffe00 }, // 0b001
+    { 0x001249200, 0x001249200, 0x001249200, 0x001249200, 0x001249200, 0x001249200, 0x000000000, 0x001249200, 0x001249200, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x049249209, 0x040249209, 0x040249200, 0x040249200, 0x040249200, 0x040249200, 0x049249200, 0x049249200, 0x049249200, 0x049249200 }, // 0b010
+    { 0x001249200, 0x000924800, 0x000492400, 0x001249200, 0x000924800, 0x000492400, 0x000000000, 0x000924800, 0x000492400, 0x049249209, 0x124924924, 0x092492492, 0x049249209, 0x124924924, 0x092492492, 0x049249209, 0x124924924, 0x092492492, 0x049249209, 0x124924924, 0x092492492, 0x049249209, 0x124924924, 0x092492492, 0x040249209, 0x120924800, 0x080492400, 0x040249200, 0x120924800, 0x092492400, 0x049249200, 0x124924800, 0x092492400 }, // 0b011
+    { 0x0011c7000, 0x0011c7000, 0x000e38e00, 0x000e38e00, 0x0011c7000, 0x0011c7000, 0x000000000, 0x000e38e00, 0x0011c7000, 0x1c71c7187, 0x038e38e38, 0x038e38e38, 0x1c71c7187, 0x1c71c7187, 0x038e38e38, 0x038e38e38, 0x1c71c7187, 0x1c71c7187, 0x038e38e38, 0x038e38e38, 0x1c71c7187, 0x1c71c7187, 0x038e38e38, 0x038e38e38, 0x1c01c7187, 0x1c01c7000, 0x020e38e00, 0x020e38e00, 0x1c01c7000, 0x1c71c7000, 0x038e38e00, 0x038e38e00, 0x1c71c7000 }, // 0b100
+    { 0x001fffe00, 0x001041000, 0x001249200, 0x001555400, 0x001249200, 0x001041000, 0x000000000, 0x001041000, 0x001249200, 0x155555515, 0x049249209, 0x041041001, 0x1ffffffbf, 0x041041001, 0x049249209, 0x155555515, 0x049249209, 0x041041001, 0x1ffffffbf, 0x041041001, 0x049249209, 0x155555515, 0x049249209, 0x041041001, 0x1e0ffffbf, 0x040041000, 0x040249200, 0x140555400, 0x040249200, 0x041041000, 0x1fffffe00, 0x041041000, 0x049249200 }, // 0b101
+    { 0x001fffe00, 0x0011c7000, 0x0016db600, 0x001555400, 0x001b6da00, 0x001c71c00, 0x000000000, 0x0011c7000, 0x0016db600, 0x155555515, 0x16db6db2d, 0x071c71c31, 0x1ffffffbf, 0x1c71c7187, 0x0db6db69b, 0x155555515, 0x16db6db2d, 0x071c71c31, 0x1ffffffbf, 0x1c71c7187, 0x0db6db69b, 0x155555515, 0x16db6db2d, 0x071c71c31, 0x1e0ffffbf, 0x1c01c7000, 0x0c06db600, 0x140555400, 0x160b6da00, 0x071c71c00, 0x1fffffe00, 0x1c71c7000, 0x0db6db600 }, // 0b110
+    { 0x001555400, 0x000e38e00, 0x001c71c00, 0x000aaaa00, 0x0011c7000, 0x00038e200, 0x000000000, 0x000e38e00, 0x001c71c00, 0x0aaaaaaaa, 0x1c71c7187, 0x18e38e38e, 0x155555515, 0x038e38e38, 0x071c71c31, 0x0aaaaaaaa, 0x1c71c7187, 0x18e38e38e, 0x155555515, 0x038e38e38, 0x071c71c31, 0x0aaaaaaaa, 0x1c71c7187, 0x18e38e38e, 0x140555515, 0x020e38e00, 0x060c71c00, 0x0a0aaaa00, 0x1c01c7000, 0x18e38e200, 0x155555400, 0x038e38e00, 0x071c71c00 }, // 0b111
+};
+
+static const uint8_t qrtinyFormatModules[QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH][2][2] = {
+    { { 8, 0 }, { 32, 8 } },
+    { { 8, 1 }, { 31, 8 } },
+    { { 8, 2 }, { 30, 8 } },
+    { { 8, 3 }, { 29, 8 } },
+    { { 8, 4 }, { 28, 8 } },
+    { { 8, 5 }, { 27, 8 } },
+    { { 8, 7 }, { 26, 8 } },
+    { { 8, 8 }, { 25, 8 } },
+    { { 7, 8 }, { 8, 26 } },
+    { { 5, 8 }, { 8, 27 } },
+    { { 4, 8 }, { 8, 28 } },
+    { { 3, 8 }, { 8, 29 } },
+    { { 2, 8 }, { 8, 30 } },
+    { { 1, 8 }, { 8, 31 } },
+    { { 0, 8 }, { 8, 32 } },
+};
+
+static const uint16_t qrtinyColumnPairOffsets[(QRTINY_DIMENSION - 1) / 2] = {
+    0, 48, 96, 134, 172, 231, 295, 359, 423, 487, 551, 615, 679, 711, 743, 775,
+};
+
+static const uint8_t qrtinyPlacement[QRTINY_TOTAL_CAPACITY / 8 * 8][2] = {
+    { 31, 29 }, { 32, 29 }, { 31, 30 }, { 32, 30 }, { 31, 31 }, { 32, 31 }, { 31, 32 }, { 32, 32 },
+    { 31, 25 }, { 32, 25 }, { 31, 26 }, { 32, 26 }, { 31, 27 }, { 32, 27 }, { 31, 28 }, { 32, 28 },
+    { 31, 21 }, { 32, 21 }, { 31, 22 }, { 32, 22 }, { 31, 23 }, { 32, 23 }, { 31, 24 }, { 32, 24 },
+    { 31, 17 }, { 32, 17 }, { 31, 18 }, { 32, 18 }, { 31, 19 }, { 32, 19 }, { 31, 20 }, { 32, 20 },
+    { 31, 13 }, { 32, 13 }, { 31, 14 }, { 32, 14 }, { 31, 15 }, { 32, 15 }, { 31, 16 }, { 32, 16 },
+    { 31, 9 }, { 32, 9 }, { 31, 10 }, { 32, 10 }, { 31, 11 }, { 32, 11 }, { 31, 12 }, { 32, 12 },
+    { 29, 12 }, { 30, 12 }, { 29, 11 }, { 30, 11 }, { 29, 10 }, { 30, 10 }, { 29, 9 }, { 30, 9 },
+    { 29, 16 }, { 30, 16 }, { 29, 15 }, { 30, 15 }, { 29, 14 }, { 30, 14 }, { 29, 13 }, { 30, 13 },
+    { 29, 20 }, { 30, 20 }, { 29, 19 }, { 30, 19 }, { 29, 18 }, { 30, 18 }, { 29, 17 }, { 30, 17 },
+    { 29, 24 }, { 30, 24 }, { 29, 23 }, { 30, 23 }, { 29, 22 }, { 30, 22 }, { 29, 21 }, { 30, 21 },
+    { 29, 28 }, { 30, 28 }, { 29, 27 }, { 30, 27 }, { 29, 26 }, { 30, 26 }, { 29, 25 }, { 30, 25 },
+    { 29, 32 }, { 30, 32 }, { 29, 31 }, { 30, 31 }, { 29, 30 }, { 30, 30 }, { 29, 29 }, { 30, 29 },
+    { 27, 29 }, { 28, 29 }, { 27, 30 }, { 28, 30 }, { 27, 31 }, { 28, 31 }, { 27, 32 }, { 28, 32 },
+    { 27, 20 }, { 28, 20 }, { 27, 21 }, { 28, 21 }, { 27, 22 }, { 28, 22 }, { 27, 23 }, { 28, 23 },
+    { 27, 16 }, { 28, 16 }, { 27, 17 }, { 28, 17 }, { 27, 18 }, { 28, 18 }, { 27, 19 }, { 28, 19 },
+    { 27, 12 }, { 28, 12 }, { 27, 13 }, { 28, 13 }, { 27, 14 }, { 28, 14 }, { 27, 15 }, { 28, 15 },
+    { 25, 9 }, { 26, 9 }, { 27, 9 }, { 28, 9 }, { 27, 10 }, { 28, 10 }, { 27, 11 }, { 28, 11 },
+    { 25, 13 }, { 26, 13 }, { 25, 12 }, { 26, 12 }, { 25, 11 }, { 26, 11 }, { 25, 10 }, { 26, 10 },
+    { 25, 17 }, { 26, 17 }, { 25, 16 }, { 26, 16 }, { 25, 15 }, { 26, 15 }, { 25, 14 }, { 26, 14 },
+    { 25, 21 }, { 26, 21 }, { 25, 20 }, { 26, 20 }, { 25, 19 }, { 26, 19 }, { 25, 18 }, { 26, 18 },
+    { 25, 30 }, { 26, 30 }, { 25, 29 }, { 26, 29 }, { 25, 23 }, { 26, 23 }, { 25, 22 }, { 26, 22 },
+    { 23, 31 }, { 24, 31 }, { 23, 32 }, { 24, 32 }, { 25, 32 }, { 26, 32 }, { 25, 31 }, { 26, 31 },
+    { 23, 25 }, { 23, 26 }, { 23, 27 }, { 23, 28 }, { 23, 29 }, { 24, 29 }, { 23, 30 }, { 24, 30 },
+    { 24, 20 }, { 23, 21 }, { 24, 21 }, { 23, 22 }, { 24, 22 }, { 23, 23 }, { 24, 23 }, { 23, 24 },
+    { 24, 16 }, { 23, 17 }, { 24, 17 }, { 23, 18 }, { 24, 18 }, { 23, 19 }, { 24, 19 }, { 23, 20 },
+    { 24, 12 }, { 23, 13 }, { 24, 13 }, { 23, 14 }, { 24, 14 }, { 23, 15 }, { 24, 15 }, { 23, 16 },
+    { 24, 8 }, { 23, 9 }, { 24, 9 }, { 23, 10 }, { 24, 10 }, { 23, 11 }, { 24, 11 }, { 23, 12 },
+    { 24, 3 }, { 23, 4 }, { 24, 4 }, { 23, 5 }, { 24, 5 }, { 23, 7 }, { 24, 7 }, { 23, 8 },
+    { 22, 0 }, { 23, 0 }, { 24, 0 }, { 23, 1 }, { 24, 1 }, { 23, 2 }, { 24, 2 }, { 23, 3 },
+    { 22, 4 }, { 21, 3 }, { 22, 3 }, { 21, 2 }, { 22, 2 }, { 21, 1 }, { 22, 1 }, { 21, 0 },
+    { 22, 9 }, { 21, 8 }, { 22, 8 }, { 21, 7 }, { 22, 7 }, { 21, 5 }, { 22, 5 }, { 21, 4 },
+    { 22, 13 }, { 21, 12 }, { 22, 12 }, { 21, 11 }, { 22, 11 }, { 21, 10 }, { 22, 10 }, { 21, 9 },
+    { 22, 17 }, { 21, 16 }, { 22, 16 }, { 21, 15 }, { 22, 15 }, { 21, 14 }, { 22, 14 }, { 21, 13 },
+    { 22, 21 }, { 21, 20 }, { 22, 20 }, { 21, 19 }, { 22, 19 }, { 21, 18 }, { 22, 18 }, { 21, 17 },
+    { 22, 25 }, { 21, 24 }, { 22, 24 }, { 21, 23 }, { 22, 23 }, { 21, 22 }, { 22, 22 }, { 21, 21 },
+    { 22, 29 }, { 21, 28 }, { 22, 28 }, { 21, 27 }, { 22, 27 }, { 21, 26 }, { 22, 26 }, { 21, 25 },
+    { 20, 32 }, { 21, 32 }, { 22, 32 }, { 21, 31 }, { 22, 31 }, { 21, 30 }, { 22, 30 }, { 21, 29 },
+    { 20, 28 }, { 19, 29 }, { 20, 29 }, { 19, 30 }, { 20, 30 }, { 19, 31 }, { 20, 31 }, { 19, 32 },
+    { 20, 24 }, { 19, 25 }, { 20, 25 }, { 19, 26 }, { 20, 26 }, { 19, 27 }, { 20, 27 }, { 19, 28 },
+    { 20, 20 }, { 19, 21 }, { 20, 21 }, { 19, 22 }, { 20, 22 }, { 19, 23 }, { 20, 23 }, { 19, 24 },
+    { 20, 16 }, { 19, 17 }, { 20, 17 }, { 19, 18 }, { 20, 18 }, { 19, 19 }, { 20, 19 }, { 19, 20 },
+    { 20, 12 }, { 19, 13 }, { 20, 13 }, { 19, 14 }, { 20, 14 }, { 19, 15 }, { 20, 15 }, { 19, 16 },
+    { 20, 8 }, { 19, 9 }, { 20, 9 }, { 19, 10 }, { 20, 10 }, { 19, 11 }, { 20, 11 }, { 19, 12 },
+    { 20, 3 }, { 19, 4 }, { 20, 4 }, { 19, 5 }, { 20, 5 }, { 19, 7 }, { 20, 7 }, { 19, 8 },
+    { 18, 0 }, { 19, 0 }, { 20, 0 }, { 19, 1 }, { 20, 1 }, { 19, 2 }, { 20, 2 }, { 19, 3 },
+    { 18, 4 }, { 17, 3 }, { 18, 3 }, { 17, 2 }, { 18, 2 }, { 17, 1 }, { 18, 1 }, { 17, 0 },
+    { 18, 9 }, { 17, 8 }, { 18, 8 }, { 17, 7 }, { 18, 7 }, { 17, 5 }, { 18, 5 }, { 17, 4 },
+    { 18, 13 }, { 17, 12 }, { 18, 12 }, { 17, 11 }, { 18, 11 }, { 17, 10 }, { 18, 10 }, { 17, 9 },
+    { 18, 17 }, { 17, 16 }, { 18, 16 }, { 17, 15 }, { 18, 15 }, { 17, 14 }, { 18, 14 }, { 17, 13 },
+    { 18, 21 }, { 17, 20 }, { 18, 20 }, { 17, 19 }, { 18, 19 }, { 17, 18 }, { 18, 18 }, { 17, 17 },
+    { 18, 25 }, { 17, 24 }, { 18, 24 }, { 17, 23 }, { 18, 23 }, { 17, 22 }, { 18, 22 }, { 17, 21 },
+    { 18, 29 }, { 17, 28 }, { 18, 28 }, { 17, 27 }, { 18, 27 }, { 17, 26 }, { 18, 26 }, { 17, 25 },
+    { 16, 32 }, { 17, 32 }, { 18, 32 }, { 17, 31 }, { 18, 31 }, { 17, 30 }, { 18, 30 }, { 17, 29 },
+    { 16, 28 }, { 15, 29 }, { 16, 29 }, { 15, 30 }, { 16, 30 }, { 15, 31 }, { 16, 31 }, { 15, 32 },
+    { 16, 24 }, { 15, 25 }, { 16, 25 }, { 15, 26 }, { 16, 26 }, { 15, 27 }, { 16, 27 }, { 15, 28 },
+    { 16, 20 }, { 15, 21 }, { 16, 21 }, { 15, 22 }, { 16, 22 }, { 15, 23 }, { 16, 23 }, { 15, 24 },
+    { 16, 16 }, { 15, 17 }, { 16, 17 }, { 15, 18 }, { 16, 18 }, { 15, 19 }, { 16, 19 }, { 15, 20 },
+    { 16, 12 }, { 15, 13 }, { 16, 13 }, { 15, 14 }, { 16, 14 }, { 15, 15 }, { 16, 15 }, { 15, 16 },
+    { 16, 8 }, { 15, 9 }, { 16, 9 }, { 15, 10 }, { 16, 10 }, { 15, 11 }, { 16, 11 }, { 15, 12 },
+    { 16, 3 }, { 15, 4 }, { 16, 4 }, { 15, 5 }, { 16, 5 }, { 15, 7 }, { 16, 7 }, { 15, 8 },
+    { 14, 0 }, { 15, 0 }, { 16, 0 }, { 15, 1 }, { 16, 1 }, { 15, 2 }, { 16, 2 }, { 15, 3 },
+    { 14, 4 }, { 13, 3 }, { 14, 3 }, { 13, 2 }, { 14, 2 }, { 13, 1 }, { 14, 1 }, { 13, 0 },
+    { 14, 9 }, { 13, 8 }, { 14, 8 }, { 13, 7 }, { 14, 7 }, { 13, 5 }, { 14, 5 }, { 13, 4 },
+    { 14, 13 }, { 13, 12 }, { 14, 12 }, { 13, 11 }, { 14, 11 }, { 13, 10 }, { 14, 10 }, { 13, 9 },
+    { 14, 17 }, { 13, 16 }, { 14, 16 }, { 13, 15 }, { 14, 15 }, { 13, 14 }, { 14, 14 }, { 13, 13 },
+    { 14, 21 }, { 13, 20 }, { 14, 20 }, { 13, 19 }, { 14, 19 }, { 13, 18 }, { 14, 18 }, { 13, 17 },
+    { 14, 25 }, { 13, 24 }, { 14, 24 }, { 13, 23 }, { 14, 23 }, { 13, 22 }, { 14, 22 }, { 13, 21 },
+    { 14, 29 }, { 13, 28 }, { 14, 28 }, { 13, 27 }, { 14, 27 }, { 13, 26 }, { 14, 26 }, { 13, 25 },
+    { 12, 32 }, { 13, 32 }, { 14, 32 }, { 13, 31 }, { 14, 31 }, { 13, 30 }, { 14, 30 }, { 13, 29 },
+    { 12, 28 }, { 11, 29 }, { 12, 29 }, { 11, 30 }, { 12, 30 }, { 11, 31 }, { 12, 31 }, { 11, 32 },
+    { 12, 24 }, { 11, 25 }, { 12, 25 }, { 11, 26 }, { 12, 26 }, { 11, 27 }, { 12, 27 }, { 11, 28 },
+    { 12, 20 }, { 11, 21 }, { 12, 21 }, { 11, 22 }, { 12, 22 }, { 11, 23 }, { 12, 23 }, { 11, 24 },
+    { 12, 16 }, { 11, 17 }, { 12, 17 }, { 11, 18 }, { 12, 18 }, { 11, 19 }, { 12, 19 }, { 11, 20 },
+    { 12, 12 }, { 11, 13 }, { 12, 13 }, { 11, 14 }, { 12, 14 }, { 11, 15 }, { 12, 15 }, { 11, 16 },
+    { 12, 8 }, { 11, 9 }, { 12, 9 }, { 11, 10 }, { 12, 10 }, { 11, 11 }, { 12, 11 }, { 11, 12 },
+    { 12, 3 }, { 11, 4 }, { 12, 4 }, { 11, 5 }, { 12, 5 }, { 11, 7 }, { 12, 7 }, { 11, 8 },
+    { 10, 0 }, { 11, 0 }, { 12, 0 }, { 11, 1 }, { 12, 1 }, { 11, 2 }, { 12, 2 }, { 11, 3 },
+    { 10, 4 }, { 9, 3 }, { 10, 3 }, { 9, 2 }, { 10, 2 }, { 9, 1 }, { 10, 1 }, { 9, 0 },
+    { 10, 9 }, { 9, 8 }, { 10, 8 }, { 9, 7 }, { 10, 7 }, { 9, 5 }, { 10, 5 }, { 9, 4 },
+    { 10, 13 }, { 9, 12 }, { 10, 12 }, { 9, 11 }, { 10, 11 }, { 9, 10 }, { 10, 10 }, { 9, 9 },
+    { 10, 17 }, { 9, 16 }, { 10, 16 }, { 9, 15 }, { 10, 15 }, { 9, 14 }, { 10, 14 }, { 9, 13 },
+    { 10, 21 }, { 9, 20 }, { 10, 20 }, { 9, 19 }, { 10, 19 }, { 9, 18 }, { 10, 18 }, { 9, 17 },
+    { 10, 25 }, { 9, 24 }, { 10, 24 }, { 9, 23 }, { 10, 23 }, { 9, 22 }, { 10, 22 }, { 9, 21 },
+    { 10, 29 }, { 9, 28 }, { 10, 28 }, { 9, 27 }, { 10, 27 }, { 9, 26 }, { 10, 26 }, { 9, 25 },
+    { 8, 24 }, { 9, 32 }, { 10, 32 }, { 9, 31 }, { 10, 31 }, { 9, 30 }, { 10, 30 }, { 9, 29 },
+    { 8, 20 }, { 7, 21 }, { 8, 21 }, { 7, 22 }, { 8, 22 }, { 7, 23 }, { 8, 23 }, { 7, 24 },
+    { 8, 16 }, { 7, 17 }, { 8, 17 }, { 7, 18 }, { 8, 18 }, { 7, 19 }, { 8, 19 }, { 7, 20 },
+    { 8, 12 }, { 7, 13 }, { 8, 13 }, { 7, 14 }, { 8, 14 }, { 7, 15 }, { 8, 15 }, { 7, 16 },
+    { 5, 9 }, { 7, 9 }, { 8, 9 }, { 7, 10 }, { 8, 10 }, { 7, 11 }, { 8, 11 }, { 7, 12 },
+    { 5, 13 }, { 4, 12 }, { 5, 12 }, { 4, 11 }, { 5, 11 }, { 4, 10 }, { 5, 10 }, { 4, 9 },
+    { 5, 17 }, { 4, 16 }, { 5, 16 }, { 4, 15 }, { 5, 15 }, { 4, 14 }, { 5, 14 }, { 4, 13 },
+    { 5, 21 }, { 4, 20 }, { 5, 20 }, { 4, 19 }, { 5, 19 }, { 4, 18 }, { 5, 18 }, { 4, 17 },
+    { 3, 24 }, { 4, 24 }, { 5, 24 }, { 4, 23 }, { 5, 23 }, { 4, 22 }, { 5, 22 }, { 4, 21 },
+    { 3, 20 }, { 2, 21 }, { 3, 21 }, { 2, 22 }, { 3, 22 }, { 2, 23 }, { 3, 23 }, { 2, 24 },
+    { 3, 16 }, { 2, 17 }, { 3, 17 }, { 2, 18 }, { 3, 18 }, { 2, 19 }, { 3, 19 }, { 2, 20 },
+    { 3, 12 }, { 2, 13 }, { 3, 13 }, { 2, 14 }, { 3, 14 }, { 2, 15 }, { 3, 15 }, { 2, 16 },
+    { 1, 9 }, { 2, 9 }, { 3, 9 }, { 2, 10 }, { 3, 10 }, { 2, 11 }, { 3, 11 }, { 2, 12 },
+    { 1, 13 }, { 0, 12 }, { 1, 12 }, { 0, 11 }, { 1, 11 }, { 0, 10 }, { 1, 10 }, { 0, 9 },
+    { 1, 17 }, { 0, 16 }, { 1, 16 }, { 0, 15 }, { 1, 15 }, { 0, 14 }, { 1, 14 }, { 0, 13 },
+    { 1, 21 }, { 0, 20 }, { 1, 20 }, { 0, 19 }, { 1, 19 }, { 0, 18 }, { 1, 18 }, { 0, 17 },
+};
+#endif
+
+#if QRTINY_VERSION > 1
+// Determine the data bit index at a given coordinate (only valid at data module coordinates): after the data modules of the column
+// pairs to the right, and those of this column pair's rows already passed (upwards or downwards), each row's right-hand module first.
+static size_t QrTinyIdentifyIndex(int x, int y)
+{
+    int xx = x - ((x >= QRTINY_TIMING_OFFSET) ? 1 : 0);
+    int pair = (QRTINY_DIMENSION - 2 - xx) >> 1;
+    int left = x - (xx & 1);
+    int step = (pair & 1) ? 1 : -1;   // Upwards for even pairs
+    size_t index = qrtinyColumnPairOffsets[pair];
+    for (int row = (step < 0) ? QRTINY_DIMENSION - 1 : 0; row != y; row += step)
+    {
+        unsigned int data = (unsigned int)(qrtinyDataRows[row] >> left) & 3;
+        index += (data & 1) + (data >> 1);
+    }
+    if (x == left && ((qrtinyDataRows[y] >> (left + 1)) & 1)) index++;
+    return index ^ 7;   // The first module of a codeword is its most-significant bit
+}
+#endif
+
+void QrTinyRender(const uint8_t *buffer, uint16_t formatInfo, qrtiny_row_t rows[QRTINY_DIMENSION])
+{
+    QRTINY_STATS_BEGIN(RENDER);
+    // Function patterns, with the mask pattern applied to the (initially light) data modules
+    const qrtiny_row_t *maskRows = qrtinyMaskRows[QRTINY_FORMATINFO_TO_MASKPATTERN(formatInfo)];
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        rows[y] = qrtinyFunctionRows[y] | maskRows[y];
+    }
+
+    // Format info
+    for (int i = 0; i < QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH; i++)
+    {
+        if ((formatInfo >> i) & 1)
+        {
+            rows[qrtinyFormatModules[i][0][1]] |= (qrtiny_row_t)1 << qrtinyFormatModules[i][0][0];
+            rows[qrtinyFormatModules[i][1][1]] |= (qrtiny_row_t)1 << qrtinyFormatModules[i][1][0];
+        }
+    }
+
+    // Data modules: toggle the masked light module for each set bit
+    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(formatInfo);
+    for (size_t i = 0; i < QRTINY_TOTAL_CAPACITY / 8; i++)
+    {
+        const uint8_t (*placement)[2] = &qrtinyPlacement[QrTinyCodewordPosition(i, errorCorrectionLevel) << 3];
+        for (unsigned int value = buffer[i]; value; value >>= 1, placement++)
+        {
+            if (value & 1) rows[(*placement)[1]] ^= (qrtiny_row_t)1 << (*placement)[0];
+        }
+    }
+    QRTINY_STATS_END(RENDER);
+}
+
+// --- Blitting to a surface ---
+// Set pixels [start, end) of a 1 bpp line, whole bytes at a time where possible
+static void QrTinyBlitBits(uint8_t *line, size_t start, size_t end, bool dark, bool lsbFirst)
+{
+    uint8_t value = dark ? 0xff : 0x00;
+    for (; start < end && (start & 7); start++)
+    {
+        uint8_t mask = (uint8_t)(lsbFirst ? (0x01 << (start & 7)) : (0x80 >> (start & 7)));
+        line[start >> 3] = (uint8_t)((line[start >> 3] & ~mask) | (value & mask));
+    }
+    size_t bytes = (end - start) >> 3;
+    memset(line + (start >> 3), value, bytes);
+    for (start += bytes << 3; start < end; start++)
+    {
+        uint8_t mask = (uint8_t)(lsbFirst ? (0x01 << (start & 7)) : (0x80 >> (start & 7)));
+        line[start >> 3] = (uint8_t)((line[start >> 3] & ~mask) | (value & mask));
+    }
+}
+
+// Whether the module at x (including the quiet margin) of a rendered row is drawn dark
+static bool QrTinyBlitDark(qrtiny_row_t row, int x, bool invert)
+{
+    return (x >= 0 && x < QRTINY_DIMENSION && ((row >> x) & 1)) != invert;
+}
+
+bool QrTinyBlit(const uint8_t *buffer, uint16_t formatInfo, void *dst, size_t stride, int pixelFormat, int scale, int quiet, bool invert)
+{
+    if (pixelFormat < QRTINY_PIXEL_1BPP_MSB || pixelFormat > QRTINY_PIXEL_RGB565 || scale < 1 || quiet < 0) return false;
+    bool packed = (pixelFormat == QRTINY_PIXEL_1BPP_MSB || pixelFormat == QRTINY_PIXEL_1BPP_LSB);
+    size_t bytesPerPixel = (pixelFormat == QRTINY_PIXEL_RGB565) ? 2 : 1;    // Unpacked: dark and light are uniform bytes
+    size_t width = (size_t)(QRTINY_DIMENSION + 2 * quiet) * (size_t)scale;
+
+    qrtiny_row_t rows[QRTINY_DIMENSION];
+    QrTinyRender(buffer, formatInfo, rows);
+
+    uint8_t *line = (uint8_t *)dst;
+    for (int y = -quiet; y < QRTINY_DIMENSION + quiet; y++)
+    {
+        // Build the first pixel row of this module row, one run of same-colored modules at a time
+        qrtiny_row_t row = (y >= 0 && y < QRTINY_DIMENSION) ? rows[y] : 0;
+        for (int x = -quiet; x < QRTINY_DIMENSION + quiet; )
+        {
+            bool dark = QrTinyBlitDark(row, x, invert);
+            int runStart = x;
+            while (++x < QRTINY_DIMENSION + quiet && QrTinyBlitDark(row, x, invert) == dark) { }
+            size_t start = (size_t)(runStart + quiet) * (size_t)scale;
+            size_t end = (size_t)(x + quiet) * (size_t)scale;
+            if (packed) QrTinyBlitBits(line, start, end, dark, pixelFormat == QRTINY_PIXEL_1BPP_LSB);
+            else memset(line + start * bytesPerPixel, dark ? 0x00 : 0xff, (end - start) * bytesPerPixel);
+        }
+
+        // Repeat it for the scale
+        for (int i = 1; i < scale; i++)
+        {
+            uint8_t *copy = line + stride * (size_t)i;
+            if (packed)
+            {
+                memcpy(copy, line, width >> 3);
+                if (width & 7)
+                {
+                    uint8_t mask = (uint8_t)(pixelFormat == QRTINY_PIXEL_1BPP_LSB ? (0xff >> (8 - (width & 7))) : (0xff << (8 - (width & 7))));
+                    copy[width >> 3] = (uint8_t)((copy[width >> 3] & ~mask) | (line[width >> 3] & mask));
+                }
+            }
+            else memcpy(copy, line, width * bytesPerPixel);
+        }
+        line += stride * (size_t)scale;
+    }
+    return true;
+}
+
+// --- Changed regions ---
+static int QrTinyRectArea(const qrtiny_rect_t *rect)
+{
+    return rect->width * rect->height;
+}
+
+// Smallest rectangle covering both
+static qrtiny_rect_t QrTinyRectUnion(const qrtiny_rect_t *a, const qrtiny_rect_t *b)
+{
+    qrtiny_rect_t rect;
+    rect.x = a->x < b->x ? a->x : b->x;
+    rect.y = a->y < b->y ? a->y : b->y;
+    rect.width = (uint8_t)((a->x + a->width > b->x + b->width ? a->x + a->width : b->x + b->width) - rect.x);
+    rect.height = (uint8_t)((a->y + a->height > b->y + b->height ? a->y + a->height : b->y + b->height) - rect.y);
+    return rect;
+}
+
+int QrTinyDiff(const uint8_t *oldBuffer, uint16_t oldFormatInfo, const uint8_t *newBuffer, uint16_t newFormatInfo, qrtiny_rect_t rects[], int maxRects)
+{
+    if (maxRects < 1) return -1;
+    qrtiny_row_t oldRows[QRTINY_DIMENSION], newRows[QRTINY_DIMENSION];
+    QrTinyRender(oldBuffer, oldFormatInfo, oldRows);
+    QrTinyRender(newBuffer, newFormatInfo, newRows);
+
+    // Each changed row's span of columns, extending the previous rectangle where the span is the same
+    qrtiny_rect_t spans[QRTINY_DIMENSION];
+    int count = 0;
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        qrtiny_row_t changed = oldRows[y] ^ newRows[y];
+        if (changed == 0) continue;
+        int first = 0, last = QRTINY_DIMENSION - 1;
+        while (!((changed >> first) & 1)) first++;
+        while (!((changed >> last) & 1)) last--;
+        qrtiny_rect_t *previous = count > 0 ? &spans[count - 1] : NULL;
+        if (previous != NULL && previous->y + previous->height == y && previous->x == first && previous->width == last - first + 1)
+        {
+            previous->height++;
+            continue;
+        }
+        spans[count].x = (uint8_t)first;
+        spans[count].y = (uint8_t)y;
+        spans[count].width = (uint8_t)(last - first + 1);
+        spans[count].height = 1;
+        count++;
+    }
+
+    // Merge the neighbouring pair that adds the fewest unchanged modules, until there are few enough
+    while (count > maxRects)
+    {
+        int best = 0, bestCost = -1;
+        for (int i = 0; i + 1 < count; i++)
+        {
+            qrtiny_rect_t merged = QrTinyRectUnion(&spans[i], &spans[i + 1]);
+            int cost = QrTinyRectArea(&merged) - QrTinyRectArea(&spans[i]) - QrTinyRectArea(&spans[i + 1]);
+            if (bestCost < 0 || cost < bestCost)
+            {
+                bestCost = cost;
+                best = i;
+            }
+        }
+        spans[best] = QrTinyRectUnion(&spans[best], &spans[best + 1]);
+        memmove(&spans[best + 1], &spans[best + 2], (size_t)(count - best - 2) * sizeof(spans[0]));
+        count--;
+    }
+
+    memcpy(rects, spans, (size_t)count * sizeof(spans[0]));
+    return count;
+}
+
+// --- Mask selection ---
+// Format info for each error-correction level and mask pattern
+static const uint16_t qrtinyFormatInfo[1 << QRTINY_SIZE_ECL][1 << QRTINY_SIZE_MASK] = {
+    { QRTINY_FORMATINFO_MASK_000_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_001_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_010_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_011_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_100_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_101_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_110_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_111_ECC_MEDIUM },
+    { QRTINY_FORMATINFO_MASK_000_ECC_LOW, QRTINY_FORMATINFO_MASK_001_ECC_LOW, QRTINY_FORMATINFO_MASK_010_ECC_LOW, QRTINY_FORMATINFO_MASK_011_ECC_LOW, QRTINY_FORMATINFO_MASK_100_ECC_LOW, QRTINY_FORMATINFO_MASK_101_ECC_LOW, QRTINY_FORMATINFO_MASK_110_ECC_LOW, QRTINY_FORMATINFO_MASK_111_ECC_LOW },
+    { QRTINY_FORMATINFO_MASK_000_ECC_HIGH, QRTINY_FORMATINFO_MASK_001_ECC_HIGH, QRTINY_FORMATINFO_MASK_010_ECC_HIGH, QRTINY_FORMATINFO_MASK_011_ECC_HIGH, QRTINY_FORMATINFO_MASK_100_ECC_HIGH, QRTINY_FORMATINFO_MASK_101_ECC_HIGH, QRTINY_FORMATINFO_MASK_110_ECC_HIGH, QRTINY_FORMATINFO_MASK_111_ECC_HIGH },
+    { QRTINY_FORMATINFO_MASK_000_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_001_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_010_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_011_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_100_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_101_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_110_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_111_ECC_QUARTILE },
+};
+
+uint16_t QrTinyFormatInfo(int ecl, int maskPattern)
+{
+    return qrtinyFormatInfo[ecl & ((1 << QRTINY_SIZE_ECL) - 1)][maskPattern & ((1 << QRTINY_SIZE_MASK) - 1)];
+}
+
+static int QrTinyBitCount(uint32_t value)
+{
+    value = value - ((value >> 1) & 0x55555555);
+    value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+    return (int)((((value + (value >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24);
+}
+
+// A row or column with a margin of four modules either side, for penalty scoring
+#if QRTINY_DIMENSION + 8 <= 32
+typedef uint32_t qrtiny_line_t;
+#else
+typedef uint64_t qrtiny_line_t;
+#endif
+
+static int QrTinyLineBitCount(qrtiny_line_t value)
+{
+    return QrTinyBitCount((uint32_t)value) + (sizeof(value) > sizeof(uint32_t) ? QrTinyBitCount((uint32_t)(value >> 16 >> 16)) : 0);
+}
+
+#if QRTINY_DIMENSION <= 32
+// Transpose a 32x32 bit matrix (bit x of m[y] swapped with bit y of m[x])
+static void QrTinyTranspose(uint32_t m[32])
+{
+    uint32_t mask = 0x0000ffff;
+    for (int j = 16; j != 0; j >>= 1, mask ^= mask << j)
+    {
+        for (int k = 0; k < 32; k = ((k | j) + 1) & ~j)
+        {
+            uint32_t t = ((m[k] >> j) ^ m[k | j]) & mask;
+            m[k] ^= t << j;
+            m[k | j] ^= t;
+        }
+    }
+}
+#endif
+
+#define QRTINY_PENALTY_N1 3
+#define QRTINY_PENALTY_N2 3
+#define QRTINY_PENALTY_N3 40
+#define QRTINY_PENALTY_N4 10
+#define QRTINY_LINE_BITS(_n) (((qrtiny_line_t)1 << (_n)) - 1)
+
+// Penalty for a row or column (bit i is module i): same-colour runs and finder-like patterns
+static int QrTinyPenaltyLine(qrtiny_line_t line)
+{
+    // Runs of five or more same-colour modules score N1 + (length - 5): one per five-module window within the run, plus two per run
+    qrtiny_line_t same = ~(line ^ (line >> 1)) & QRTINY_LINE_BITS(QRTINY_DIMENSION - 1);   // bit i: module i matches module i + 1
+    qrtiny_line_t five = same & (same >> 1) & (same >> 2) & (same >> 3);                    // bit i: modules i to i + 4 match
+    int penalty = QrTinyLineBitCount(five) + (QRTINY_PENALTY_N1 - 1) * QrTinyLineBitCount(five & ~(five << 1));
+
+    // Finder-like pattern (dark-light-dark-dark-dark-light-dark) with four light modules before or after (light beyond the edges)
+    qrtiny_line_t dark = line << 4;
+    qrtiny_line_t light = ~dark & QRTINY_LINE_BITS(QRTINY_DIMENSION + 8);
+    qrtiny_line_t core = dark & (light >> 1) & (dark >> 2) & (dark >> 3) & (dark >> 4) & (light >> 5) & (dark >> 6);    // bit i: modules i to i + 6 match 1011101
+    if (core)
+    {
+        qrtiny_line_t after = core & (light >> 7) & (light >> 8) & (light >> 9) & (light >> 10);
+        qrtiny_line_t before = core & (light << 1) & (light << 2) & (light << 3) & (light << 4);
+        penalty += QRTINY_PENALTY_N3 * (QrTinyLineBitCount(after) + QrTinyLineBitCount(before));
+    }
+    return penalty;
+}
+
+// Calculate the penalty score for a rendered symbol
+static int QrTinyPenalty(const qrtiny_row_t rows[QRTINY_DIMENSION])
+{
+#if QRTINY_DIMENSION <= 32
+    uint32_t columns[32] = { 0 };
+    memcpy(columns, rows, QRTINY_DIMENSION * sizeof(rows[0]));
+    QrTinyTranspose(columns);
+#else
+    qrtiny_row_t columns[QRTINY_DIMENSION] = { 0 };
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        for (int x = 0; x < QRTINY_DIMENSION; x++) columns[x] |= ((rows[y] >> x) & 1) << y;
+    }
+#endif
+
+    int penalty = 0;
+    int dark = 0;
+    for (int i = 0; i < QRTINY_DIMENSION; i++)
+    {
+        penalty += QrTinyPenaltyLine(rows[i]) + QrTinyPenaltyLine(columns[i]);
+        dark += QrTinyLineBitCount(rows[i]);
+    }
+
+    // 2x2 blocks of the same colour
+    for (int y = 0; y < QRTINY_DIMENSION - 1; y++)
+    {
+        qrtiny_line_t a = rows[y], b = rows[y + 1];
+        qrtiny_line_t blocks = ((a & (a >> 1) & b & (b >> 1)) | ~(a | (a >> 1) | b | (b >> 1))) & QRTINY_LINE_BITS(QRTINY_DIMENSION - 1);
+        penalty += QRTINY_PENALTY_N2 * QrTinyLineBitCount(blocks);
+    }
+
+    // Proportion of dark modules: N4 for each whole 5% away from 50%
+    int total = QRTINY_DIMENSION * QRTINY_DIMENSION;
+    penalty += QRTINY_PENALTY_N4 * ((abs(dark * 20 - total * 10) + total - 1) / total - 1);
+    return penalty;
+}
+
+uint16_t QrTinyChooseMask(const uint8_t *buffer, int ecl)
+{
+    QRTINY_STATS_BEGIN(MASK);
+    // Render once, then remove the mask pattern to leave the unmasked data
+    uint16_t baseFormatInfo = QrTinyFormatInfo(ecl, 0);
+    qrtiny_row_t base[QRTINY_DIMENSION];
+    QrTinyRender(buffer, baseFormatInfo, base);
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        base[y] ^= qrtinyMaskRows[0][y];
+    }
+
+    uint16_t bestFormatInfo = baseFormatInfo;
+    int bestPenalty = -1;
+    for (int maskPattern = 0; maskPattern < (1 << QRTINY_SIZE_MASK); maskPattern++)
+    {
+        uint16_t formatInfo = QrTinyFormatInfo(ecl, maskPattern);
+        qrtiny_row_t rows[QRTINY_DIMENSION];
+        for (int y = 0; y < QRTINY_DIMENSION; y++)
+        {
+            rows[y] = base[y] ^ qrtinyMaskRows[maskPattern][y];
+        }
+        // Format info modules that differ from the base rendering
+        uint16_t formatChange = formatInfo ^ baseFormatInfo;
+        for (int i = 0; i < QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH; i++)
+        {
+            if ((formatChange >> i) & 1)
+            {
+                rows[qrtinyFormatModules[i][0][1]] ^= (qrtiny_row_t)1 << qrtinyFormatModules[i][0][0];
+                rows[qrtinyFormatModules[i][1][1]] ^= (qrtiny_row_t)1 << qrtinyFormatModules[i][1][0];
+            }
+        }
+        int penalty = QrTinyPenalty(rows);
+        if (bestPenalty < 0 || penalty < bestPenalty)
+        {
+            bestPenalty = penalty;
+            bestFormatInfo = formatInfo;
+        }
+    }
+    QRTINY_STATS_END(MASK);
+    return bestFormatInfo;
+}
+
+// --- Template and delta ---
+// Product modulo GF(2^8/0x011D)
+static uint8_t QrTinyGFMultiply(uint8_t a, uint8_t b)
+{
+#ifdef QRTINY_RS_TABLES
+    if (a == 0 || b == 0) return 0;
+    return qrtinyGFExp[qrtinyGFLog[a] + qrtinyGFLog[b]];
+#else
+    uint8_t value = 0;
+    for (int k = 7; k >= 0; k--)
+    {
+        value = (uint8_t)((value << 1) ^ ((value >> 7) * 0x011D));
+        value ^= ((a >> k) & 1) * b;
+    }
+    return value;
+#endif
+}
+
+// Toggle the modules of the set bits of a change to a codeword
+static void QrTinyToggleCodeword(qrtiny_row_t rows[QRTINY_DIMENSION], size_t codeword, int errorCorrectionLevel, unsigned int change)
+{
+    const uint8_t (*placement)[2] = &qrtinyPlacement[QrTinyCodewordPosition(codeword, errorCorrectionLevel) << 3];
+    for (; change; change >>= 1, placement++)
+    {
+        if (change & 1) rows[(*placement)[1]] ^= (qrtiny_row_t)1 << (*placement)[0];
+    }
+}
+
+void QrTinyTemplateInit(qrtiny_template_t *tmpl, const uint8_t *buffer, uint16_t formatInfo)
+{
+    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(formatInfo);
+    tmpl->formatInfo = formatInfo;
+    tmpl->eccCodewords = qrcode_ecc_block_codewords[errorCorrectionLevel];
+    tmpl->blocks = qrcode_ecc_blocks[errorCorrectionLevel];
+    tmpl->dataCodewords = (int)QrTinyDataCodewords(errorCorrectionLevel);
+    memcpy(tmpl->buffer, buffer, sizeof(tmpl->buffer));
+    memcpy(tmpl->committed, buffer, sizeof(tmpl->committed));
+    QrTinyRender(tmpl->committed, formatInfo, tmpl->rows);
+
+    // The remainder is linear over GF(2^8): a data codeword at position i of a block contributes its value times the remainder of a
+    // unit codeword at that position, which is the remainder of a unit codeword followed by the (blockData - 1 - i) zero codewords.
+    static const uint8_t unit[QRTINY_DATA_CODEWORDS_MAX] = { 1 };
+    int blockData = tmpl->dataCodewords / tmpl->blocks;
+    for (int i = 0; i < blockData; i++)
+    {
+        QrTinyRSRemainder(unit, (size_t)(blockData - i), eccDivisors[errorCorrectionLevel], tmpl->eccCodewords, tmpl->eccContribution[i]);
+    }
+}
+
+static void QrTinyTemplateUpdateCodewords(qrtiny_template_t *tmpl, size_t bitPosition, size_t bitCount)
+{
+    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(tmpl->formatInfo);
+    size_t blockData = (size_t)(tmpl->dataCodewords / tmpl->blocks);
+    size_t start = bitPosition >> 3;
+    size_t end = (bitPosition + bitCount + 7) >> 3;
+    if (end > (size_t)tmpl->dataCodewords) end = (size_t)tmpl->dataCodewords;
+
+    // Changed data codewords: toggle their modules, and sum their contribution to the change in their block's error-correction codewords
+    uint8_t eccChange[QRTINY_ECC_BLOCKS_MAX][QRTINY_ECC_CODEWORDS_MAX] = { { 0 } };
+    bool changed = false;
+    for (size_t i = start; i < end; i++)
+    {
+        uint8_t change = tmpl->buffer[i] ^ tmpl->committed[i];
+        if (change == 0) continue;
+        tmpl->committed[i] = tmpl->buffer[i];
+        QrTinyToggleCodeword(tmpl->rows, i, errorCorrectionLevel, change);
+        uint8_t *blockChange = eccChange[i / blockData];
+        const uint8_t *contribution = tmpl->eccContribution[i % blockData];
+        for (int j = 0; j < tmpl->eccCodewords; j++)
+        {
+            blockChange[j] ^= QrTinyGFMultiply(change, contribution[j]);
+        }
+        changed = true;
+    }
+    if (!changed) return;
+
+    // Changed error-correction codewords
+    for (int block = 0; block < tmpl->blocks; block++)
+    {
+        for (int j = 0; j < tmpl->eccCodewords; j++)
+        {
+            if (eccChange[block][j] == 0) continue;
+            size_t i = (size_t)(tmpl->dataCodewords + block * tmpl->eccCodewords + j);
+            tmpl->buffer[i] ^= eccChange[block][j];
+            tmpl->committed[i] = tmpl->buffer[i];
+            QrTinyToggleCodeword(tmpl->rows, i, errorCorrectionLevel, eccChange[block][j]);
+        }
+    }
+}
+
+void QrTinyTemplateUpdate(qrtiny_template_t *tmpl, size_t bitPosition, size_t bitCount)
+{
+    QRTINY_STATS_BEGIN(TEMPLATE);
+    QrTinyTemplateUpdateCodewords(tmpl, bitPosition, bitCount);
+    QRTINY_STATS_END(TEMPLATE);
+}
+
+// --- Verification and decoding ---
+// Misdecode protection codewords of each block (for each error-correction level), not used for correction
+#if QRTINY_VERSION == 1
+static const int8_t qrtinyMisdecodeProtection[1 << QRTINY_SIZE_ECL] = { 2, 3, 1, 1 };
+#elif QRTINY_VERSION == 2
+static const int8_t qrtinyMisdecodeProtection[1 << QRTINY_SIZE_ECL] = { 0, 2, 0, 0 };
+#elif QRTINY_VERSION == 3
+static const int8_t qrtinyMisdecodeProtection[1 << QRTINY_SIZE_ECL] = { 0, 1, 0, 0 };
+#else
+static const int8_t qrtinyMisdecodeProtection[1 << QRTINY_SIZE_ECL] = { 0, 0, 0, 0 };
+#endif
+
+// Alphanumeric characters by value
+static const char qrtinyAlphanumeric[45] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', ' ', '$', '%', '*', '+', '-', '.', '/', ':',
+};
+
+// Multiplicative inverse in GF(2^8/0x011D) of a non-zero element (a^254)
+static uint8_t QrTinyGFInverse(uint8_t a)
+{
+    uint8_t result = 1;
+    for (int i = 0; i < 7; i++)
+    {
+        a = QrTinyGFMultiply(a, a);
+        result = QrTinyGFMultiply(result, a);
+    }
+    return result;
+}
+
+// Evaluate a polynomial (coefficient i for x^i) at x
+static uint8_t QrTinyPolyEvaluate(const uint8_t poly[], int count, uint8_t x)
+{
+    uint8_t value = 0;
+    for (int i = count - 1; i >= 0; i--)
+    {
+        value = QrTinyGFMultiply(value, x) ^ poly[i];
+    }
+    return value;
+}
+
+// Whether the error-correction codewords of a block (following its data codewords) match the data codewords
+static bool QrTinyCheck(const uint8_t *block, size_t blockData, int errorCorrectionLevel)
+{
+    int eccCodewords = qrcode_ecc_block_codewords[errorCorrectionLevel];
+    uint8_t remainder[QRTINY_ECC_CODEWORDS_MAX];
+    QrTinyRSRemainder(block, blockData, eccDivisors[errorCorrectionLevel], eccCodewords, remainder);
+    return memcmp(remainder, block + blockData, (size_t)eccCodewords) == 0;
+}
+
+// Syndromes of a block's codewords: the received polynomial at the generator roots a^0 to a^(eccCodewords-1)
+static void QrTinySyndromes(const uint8_t *block, size_t blockLength, int eccCodewords, uint8_t syndromes[QRTINY_ECC_CODEWORDS_MAX])
+{
+    uint8_t root = 1;
+    for (int i = 0; i < eccCodewords; i++, root = QrTinyGFMultiply(root, 0x02))
+    {
+        uint8_t value = 0;
+        for (size_t j = 0; j < blockLength; j++)
+        {
+            value = QrTinyGFMultiply(value, root) ^ block[j];
+        }
+        syndromes[i] = value;
+    }
+}
+
+// Correct errors in a block's codewords from the (non-zero) syndromes, returning the number of codewords corrected, or -1 if uncorrectable
+static int QrTinyCorrect(uint8_t *block, size_t blockLength, int eccCodewords, int maxErrors, const uint8_t syndromes[QRTINY_ECC_CODEWORDS_MAX])
+{
+    // Berlekamp-Massey: error locator polynomial
+    uint8_t locator[QRTINY_ECC_CODEWORDS_MAX + 1] = { 1 };
+    uint8_t previous[QRTINY_ECC_CODEWORDS_MAX + 1] = { 1 };
+    int errors = 0;
+    int shift = 1;
+    uint8_t previousDiscrepancy = 1;
+    for (int n = 0; n < eccCodewords; n++)
+    {
+        uint8_t discrepancy = syndromes[n];
+        for (int i = 1; i <= errors; i++) discrepancy ^= QrTinyGFMultiply(locator[i], syndromes[n - i]);
+        if (discrepancy == 0) { shift++; continue; }
+        uint8_t scale = QrTinyGFMultiply(discrepancy, QrTinyGFInverse(previousDiscrepancy));
+        uint8_t saved[QRTINY_ECC_CODEWORDS_MAX + 1];
+        memcpy(saved, locator, sizeof(saved));
+        for (int i = 0; i + shift <= eccCodewords; i++) locator[i + shift] ^= QrTinyGFMultiply(scale, previous[i]);
+        if (2 * errors <= n)
+        {
+            errors = n + 1 - errors;
+            memcpy(previous, saved, sizeof(previous));
+            previousDiscrepancy = discrepancy;
+            shift = 1;
+        }
+        else
+        {
+            shift++;
+        }
+    }
+    if (errors > maxErrors) return -1;
+
+    // Error evaluator polynomial: syndromes * locator, modulo x^eccCodewords
+    uint8_t evaluator[QRTINY_ECC_CODEWORDS_MAX] = { 0 };
+    for (int i = 0; i < eccCodewords; i++)
+    {
+        for (int j = 0; j <= i && j <= errors; j++) evaluator[i] ^= QrTinyGFMultiply(syndromes[i - j], locator[j]);
+    }
+
+    // Chien search for the error positions, and Forney for the error values (first consecutive root 0: value = X * evaluator(1/X) / locator'(1/X))
+    int found = 0;
+    uint8_t location = 1;    // X = a^degree, codeword (blockLength - 1 - degree)
+    for (int degree = 0; degree < (int)blockLength; degree++, location = QrTinyGFMultiply(location, 0x02))
+    {
+        uint8_t inverse = QrTinyGFInverse(location);
+        if (QrTinyPolyEvaluate(locator, errors + 1, inverse) != 0) continue;
+        uint8_t derivative = 0;
+        uint8_t power = 1;   // inverse^(i-1), for odd i
+        uint8_t inverseSquared = QrTinyGFMultiply(inverse, inverse);
+        for (int i = 1; i <= errors; i += 2, power = QrTinyGFMultiply(power, inverseSquared)) derivative ^= QrTinyGFMultiply(locator[i], power);
+        if (derivative == 0) return -1;
+        uint8_t value = QrTinyGFMultiply(QrTinyGFMultiply(location, QrTinyPolyEvaluate(evaluator, eccCodewords, inverse)), QrTinyGFInverse(derivative));
+        block[blockLength - 1 - degree] ^= value;
+        found++;
+    }
+    if (found != errors) return -1;
+    return found;
+}
+
+static int QrTinyVerifySymbol(const qrtiny_row_t rows[QRTINY_DIMENSION], uint8_t *buffer, uint16_t *formatInfo)
+{
+    // Format info: the valid value nearest to either copy
+    uint16_t formatCopy[2] = { 0, 0 };
+    for (int i = 0; i < QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH; i++)
+    {
+        for (int c = 0; c < 2; c++)
+        {
+            formatCopy[c] |= (uint16_t)(((rows[qrtinyFormatModules[i][c][1]] >> qrtinyFormatModules[i][c][0]) & 1) << i);
+        }
+    }
+    int bestDistance = QRTINY_SIZE_ECL + QRTINY_SIZE_MASK + QRTINY_SIZE_BCH + 1;
+    for (int ecl = 0; ecl < (1 << QRTINY_SIZE_ECL); ecl++)
+    {
+        for (int maskPattern = 0; maskPattern < (1 << QRTINY_SIZE_MASK); maskPattern++)
+        {
+            for (int c = 0; c < 2; c++)
+            {
+                int distance = QrTinyBitCount(qrtinyFormatInfo[ecl][maskPattern] ^ formatCopy[c]);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    *formatInfo = qrtinyFormatInfo[ecl][maskPattern];
+                }
+            }
+        }
+    }
+    if (bestDistance > 3) return -1;    // The (15,5) BCH code corrects up to 3 bit errors
+
+    // Function patterns must be intact
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        if ((rows[y] & qrtinyFunctionMaskRows[y]) != qrtinyFunctionRows[y]) return -1;
+    }
+
+    // Codewords: unmask the data modules
+    int errorCorrectionLevel = QRTINY_FORMATINFO_TO_ECL(*formatInfo);
+    const qrtiny_row_t *maskRows = qrtinyMaskRows[QRTINY_FORMATINFO_TO_MASKPATTERN(*formatInfo)];
+    for (size_t i = 0; i < QRTINY_TOTAL_CAPACITY / 8; i++)
+    {
+        const uint8_t (*placement)[2] = &qrtinyPlacement[QrTinyCodewordPosition(i, errorCorrectionLevel) << 3];
+        uint8_t value = 0;
+        for (int bit = 0; bit < 8; bit++, placement++)
+        {
+            int y = (*placement)[1];
+            value |= (uint8_t)((((rows[y] ^ maskRows[y]) >> (*placement)[0]) & 1) << bit);
+        }
+        buffer[i] = value;
+    }
+    for (size_t i = QRTINY_TOTAL_CAPACITY / 8; i < QRTINY_BUFFER_SIZE; i++) buffer[i] = 0;
+
+    // Each block: its data codewords, then its error-correction codewords
+    int eccCodewords = qrcode_ecc_block_codewords[errorCorrectionLevel];
+    int blocks = qrcode_ecc_blocks[errorCorrectionLevel];
+    size_t dataCodewords = QrTinyDataCodewords(errorCorrectionLevel);
+    size_t blockData = dataCodewords / (size_t)blocks;
+    int corrected = 0;
+    for (int b = 0; b < blocks; b++)
+    {
+        uint8_t block[QRTINY_TOTAL_CAPACITY / 8];
+        uint8_t *data = buffer + (size_t)b * blockData;
+        uint8_t *ecc = buffer + dataCodewords + (size_t)b * (size_t)eccCodewords;
+        memcpy(block, data, blockData);
+        memcpy(block + blockData, ecc, (size_t)eccCodewords);
+
+        // An error-free block has the error-correction codewords of its data (as quick to check as to generate)
+        if (QrTinyCheck(block, blockData, errorCorrectionLevel)) continue;
+
+        // Otherwise, correct from the syndromes
+        uint8_t syndromes[QRTINY_ECC_CODEWORDS_MAX];
+        QrTinySyndromes(block, blockData + (size_t)eccCodewords, eccCodewords, syndromes);
+        int blockCorrected = QrTinyCorrect(block, blockData + (size_t)eccCodewords, eccCodewords, (eccCodewords - qrtinyMisdecodeProtection[errorCorrectionLevel]) / 2, syndromes);
+        if (blockCorrected < 0 || !QrTinyCheck(block, blockData, errorCorrectionLevel)) return -1;
+        memcpy(data, block, blockData);
+        memcpy(ecc, block + blockData, (size_t)eccCodewords);
+        corrected += blockCorrected;
+    }
+    return corrected;
+}
+
+int QrTinyVerify(const qrtiny_row_t rows[QRTINY_DIMENSION], uint8_t *buffer, uint16_t *formatInfo)
+{
+    QRTINY_STATS_BEGIN(VERIFY);
+    int result = QrTinyVerifySymbol(rows, buffer, formatInfo);
+    QRTINY_STATS_END(VERIFY);
+    return result;
+}
+
+// Read bits (most-significant first) from the buffer
+static uint32_t QrTinyReadBits(const uint8_t *buffer, size_t *bitPosition, int bitCount)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < bitCount; i++, (*bitPosition)++)
+    {
+        value = (value << 1) | ((buffer[*bitPosition >> 3] >> (7 - (*bitPosition & 7))) & 1);
+    }
+    return value;
+}
+
+int QrTinyDecode(const uint8_t *buffer, uint16_t formatInfo, char *text, size_t textSize)
+{
+    size_t dataCapacity = QrTinyDataCodewords(QRTINY_FORMATINFO_TO_ECL(formatInfo)) * 8;
+    size_t bitPosition = 0;
+    size_t length = 0;
+    if (textSize == 0) return -1;
+    while (dataCapacity - bitPosition >= QRTINY_SIZE_MODE_INDICATOR)
+    {
+        uint32_t mode = QrTinyReadBits(buffer, &bitPosition, QRTINY_SIZE_MODE_INDICATOR);
+        if (mode == QRTINY_MODE_INDICATOR_TERMINATOR) break;
+
+        // Segment header, and check the segment fits within the data capacity and the text buffer
+        size_t count;
+        size_t segmentBits;
+        switch (mode)
+        {
+            case QRTINY_MODE_INDICATOR_NUMERIC:
+                if (dataCapacity - bitPosition < QRTINY_MODE_NUMERIC_COUNT_BITS) return -1;
+                count = QrTinyReadBits(buffer, &bitPosition, QRTINY_MODE_NUMERIC_COUNT_BITS);
+                segmentBits = QRTINY_SEGMENT_NUMERIC_BUFFER_BITS(count) - QRTINY_SIZE_MODE_INDICATOR - QRTINY_MODE_NUMERIC_COUNT_BITS;
+                break;
+            case QRTINY_MODE_INDICATOR_ALPHANUMERIC:
+                if (dataCapacity - bitPosition < QRTINY_MODE_ALPHANUMERIC_COUNT_BITS) return -1;
+                count = QrTinyReadBits(buffer, &bitPosition, QRTINY_MODE_ALPHANUMERIC_COUNT_BITS);
+                segmentBits = QRTINY_SEGMENT_ALPHANUMERIC_BUFFER_BITS(count) - QRTINY_SIZE_MODE_INDICATOR - QRTINY_MODE_ALPHANUMERIC_COUNT_BITS;
+                break;
+            case QRTINY_MODE_INDICATOR_8_BIT:
+                if (dataCapacity - bitPosition < QRTINY_MODE_8BIT_COUNT_BITS) return -1;
+                count = QrTinyReadBits(buffer, &bitPosition, QRTINY_MODE_8BIT_COUNT_BITS);
+                segmentBits = QRTINY_SEGMENT_8_BIT_BUFFER_BITS(count) - QRTINY_SIZE_MODE_INDICATOR - QRTINY_MODE_8BIT_COUNT_BITS;
+                break;
+            default:
+                return -1;  // Unsupported mode (ECI, Kanji, structured append, FNC1)
+        }
+        if (segmentBits > dataCapacity - bitPosition || count >= textSize - length) return -1;
+
+        // Segment data
+        char *out = text + length;
+        length += count;
+        if (mode == QRTINY_MODE_INDICATOR_NUMERIC)
+        {
+            // Groups of 3/2/1 digits from 10/7/4-bit binary
+            while (count > 0)
+            {
+                int digits = count >= 3 ? 3 : (int)count;
+                uint32_t value = QrTinyReadBits(buffer, &bitPosition, digits * 3 + 1);
+                if (value >= (digits == 3 ? 1000u : digits == 2 ? 100u : 10u)) return -1;
+                for (int d = digits - 1; d >= 0; d--, value /= 10) out[d] = (char)('0' + value % 10);
+                out += digits;
+                count -= (size_t)digits;
+            }
+        }
+        else if (mode == QRTINY_MODE_INDICATOR_ALPHANUMERIC)
+        {
+            // Pairs from 11-bit (a * 45 + b); odd remainder from 6-bit
+            for (; count >= 2; count -= 2)
+            {
+                uint32_t value = QrTinyReadBits(buffer, &bitPosition, 11);
+                if (value >= 45 * 45) return -1;
+                *out++ = qrtinyAlphanumeric[value / 45];
+                *out++ = qrtinyAlphanumeric[value % 45];
+            }
+            if (count)
+            {
+                uint32_t value = QrTinyReadBits(buffer, &bitPosition, 6);
+                if (value >= 45) return -1;
+                *out++ = qrtinyAlphanumeric[value];
+            }
+        }
+        else
+        {
+            for (; count > 0; count--) *out++ = (char)QrTinyReadBits(buffer, &bitPosition, 8);
+        }
+    }
+    text[length] = '\0';
+    return (int)length;
+}
@@ -1,4 +1,4 @@
-// QR Code V1 Generator
+// QR Code V1-V4 Generator
 // Dan Jackson, 2020
 
 #ifndef QRTINY_H
@@ -15,9 +15,29 @@ extern "C" {
 #define QRTINY_QUIET_NONE 0
 #define QRTINY_QUIET_STANDARD 4
 
-// This tiny creator only supports V1 QR Codes, 21x21 modules
+// Version of the QR Codes generated, fixed for the build: V1 (21x21 modules) by default, or define QRTINY_VERSION as 2-4 (25x25 to
+// 33x33 modules, for longer payloads) when compiling every source.  Each version has its own constant geometry and tables.
+#ifndef QRTINY_VERSION
 #define QRTINY_VERSION 1
-#define QRTINY_DIMENSION 21
+#endif
+#if QRTINY_VERSION < 1 || QRTINY_VERSION > 4
+#error "QRTINY_VERSION must be 1-4"
+#endif
+#define QRTINY_DIMENSION (17 + 4 * (QRTINY_VERSION))
+
+// A packed row of modules (bit x is the module at x), wide enough for the version
+#if QRTINY_DIMENSION <= 32
+typedef uint32_t qrtiny_row_t;
+#else
+typedef uint64_t qrtiny_row_t;
+#endif
+
+// A packed row including a quiet margin of up to QRTINY_QUIET_STANDARD modules on each side (29 bits for V1), for QrTinyRowGet()
+#if QRTINY_DIMENSION + 2 * QRTINY_QUIET_STANDARD <= 32
+typedef uint32_t qrtiny_quiet_row_t;
+#else
+typedef uint64_t qrtiny_quiet_row_t;
+#endif
 
 // Total data modules (raw: data, ecc and remainder) minus function pattern and format/version = data capacity in bits
 #define QRTINY_TOTAL_CAPACITY (((16 * (size_t)(QRTINY_VERSION) + 128) * (size_t)(QRTINY_VERSION)) + 64 - ((size_t)(QRTINY_VERSION) < 2 ? 0 : (25 * ((size_t)(QRTINY_VERSION) / 7 + 2) - 10) * (size_t)((QRTINY_VERSION) / 7 + 2) - 55) - ((size_t)(QRTINY_VERSION) < 7 ? 0 : 36))
@@ -62,16 +82,233 @@ extern "C" {
 #define QRTINY_FORMATINFO_MASK_110_ECC_QUARTILE 0x2eda
 #define QRTINY_FORMATINFO_MASK_111_ECC_QUARTILE 0x2bed
 
+// Error-correction levels (as encoded in the format info)
+#define QRTINY_ECL_MEDIUM   0x0
+#define QRTINY_ECL_LOW      0x1
+#define QRTINY_ECL_HIGH     0x2
+#define QRTINY_ECL_QUARTILE 0x3
+
+// [Table 9] Number of error correction codewords in each block, and number of blocks (for each error-correction level), as initializers.
+// The blocks of a symbol (V1-V4) all have the same number of data codewords.  QRTINY_ECC_CODEWORDS_MIN is the fewest error-correction
+// codewords in total, and QRTINY_ECC_CODEWORDS_MAX the most in one block.
+// Reed-Solomon generator polynomials (for each error-correction level), as initializers.
+#if QRTINY_VERSION == 1
+#define QRTINY_ECC_BLOCK_CODEWORDS \
+    10, /* 0b00 Medium */ \
+    7,  /* 0b01 Low */ \
+    17, /* 0b10 High */ \
+    13, /* 0b11 Quartile */
+#define QRTINY_ECC_BLOCKS 1, 1, 1, 1,
+#define QRTINY_ECC_BLOCKS_MAX 1
+#define QRTINY_ECC_CODEWORDS_MIN 7
+#define QRTINY_ECC_CODEWORDS_MAX 17
+#define QRTINY_ECC_DIVISORS_MEDIUM   0xd8, 0xc2, 0x9f, 0x6f, 0xc7, 0x5e, 0x5f, 0x71, 0x9d, 0xc1 // V1 0b00 Medium ECL
+#define QRTINY_ECC_DIVISORS_LOW      0x7f, 0x7a, 0x9a, 0xa4, 0x0b, 0x44, 0x75 // V1 0b01 Low ECL
+#define QRTINY_ECC_DIVISORS_HIGH     0x77, 0x42, 0x53, 0x78, 0x77, 0x16, 0xc5, 0x53, 0xf9, 0x29, 0x8f, 0x86, 0x55, 0x35, 0x7d, 0x63, 0x4f // V1 0b10 High ECL
+#define QRTINY_ECC_DIVISORS_QUARTILE 0x89, 0x49, 0xe3, 0x11, 0xb1, 0x11, 0x34, 0x0d, 0x2e, 0x2b, 0x53, 0x84, 0x78 // V1 0b11 Quartile ECL
+#elif QRTINY_VERSION == 2
+#define QRTINY_ECC_BLOCK_CODEWORDS \
+    16, /* 0b00 Medium */ \
+    10, /* 0b01 Low */ \
+    28, /* 0b10 High */ \
+    22, /* 0b11 Quartile */
+#define QRTINY_ECC_BLOCKS 1, 1, 1, 1,
+#define QRTINY_ECC_BLOCKS_MAX 1
+#define QRTINY_ECC_CODEWORDS_MIN 10
+#define QRTINY_ECC_CODEWORDS_MAX 28
+#define QRTINY_ECC_DIVISORS_MEDIUM   0x3b, 0x0d, 0x68, 0xbd, 0x44, 0xd1, 0x1e, 0x08, 0xa3, 0x41, 0x29, 0xe5, 0x62, 0x32, 0x24, 0x3b // V2 0b00 Medium ECL
+#define QRTINY_ECC_DIVISORS_LOW      0xd8, 0xc2, 0x9f, 0x6f, 0xc7, 0x5e, 0x5f, 0x71, 0x9d, 0xc1 // V2 0b01 Low ECL
+#define QRTINY_ECC_DIVISORS_HIGH     0xfc, 0x09, 0x1c, 0x0d, 0x12, 0xfb, 0xd0, 0x96, 0x67, 0xae, 0x64, 0x29, 0xa7, 0x0c, 0xf7, 0x38, 0x75, 0x77, 0xe9, 0x7f, 0xb5, 0x64, 0x79, 0x93, 0xb0, 0x4a, 0x3a, 0xc5 // V2 0b10 High ECL
+#define QRTINY_ECC_DIVISORS_QUARTILE 0x59, 0xb3, 0x83, 0xb0, 0xb6, 0xf4, 0x13, 0xbd, 0x45, 0x28, 0x1c, 0x89, 0x1d, 0x7b, 0x43, 0xfd, 0x56, 0xda, 0xe6, 0x1a, 0x91, 0xf5 // V2 0b11 Quartile ECL
+#elif QRTINY_VERSION == 3
+#define QRTINY_ECC_BLOCK_CODEWORDS \
+    26, /* 0b00 Medium */ \
+    15, /* 0b01 Low */ \
+    22, /* 0b10 High */ \
+    18, /* 0b11 Quartile */
+#define QRTINY_ECC_BLOCKS 1, 1, 2, 2,
+#define QRTINY_ECC_BLOCKS_MAX 2
+#define QRTINY_ECC_CODEWORDS_MIN 15
+#define QRTINY_ECC_CODEWORDS_MAX 26
+#define QRTINY_ECC_DIVISORS_MEDIUM   0xf6, 0x33, 0xb7, 0x04, 0x88, 0x62, 0xc7, 0x98, 0x4d, 0x38, 0xce, 0x18, 0x91, 0x28, 0xd1, 0x75, 0xe9, 0x2a, 0x87, 0x44, 0x46, 0x90, 0x92, 0x4d, 0x2b, 0x5e // V3 0b00 Medium ECL
+#define QRTINY_ECC_DIVISORS_LOW      0x1d, 0xc4, 0x6f, 0xa3, 0x70, 0x4a, 0x0a, 0x69, 0x69, 0x8b, 0x84, 0x97, 0x20, 0x86, 0x1a // V3 0b01 Low ECL
+#define QRTINY_ECC_DIVISORS_HIGH     0x59, 0xb3, 0x83, 0xb0, 0xb6, 0xf4, 0x13, 0xbd, 0x45, 0x28, 0x1c, 0x89, 0x1d, 0x7b, 0x43, 0xfd, 0x56, 0xda, 0xe6, 0x1a, 0x91, 0xf5 // V3 0b10 High ECL
+#define QRTINY_ECC_DIVISORS_QUARTILE 0xef, 0xfb, 0xb7, 0x71, 0x95, 0xaf, 0xc7, 0xd7, 0xf0, 0xdc, 0x49, 0x52, 0xad, 0x4b, 0x20, 0x43, 0xd9, 0x92 // V3 0b11 Quartile ECL
+#elif QRTINY_VERSION == 4
+#define QRTINY_ECC_BLOCK_CODEWORDS \
+    18, /* 0b00 Medium */ \
+    20, /* 0b01 Low */ \
+    16, /* 0b10 High */ \
+    26, /* 0b11 Quartile */
+#define QRTINY_ECC_BLOCKS 2, 1, 4, 2,
+#define QRTINY_ECC_BLOCKS_MAX 4
+#define QRTINY_ECC_CODEWORDS_MIN 20
+#define QRTINY_ECC_CODEWORDS_MAX 26
+#define QRTINY_ECC_DIVISORS_MEDIUM   0xef, 0xfb, 0xb7, 0x71, 0x95, 0xaf, 0xc7, 0xd7, 0xf0, 0xdc, 0x49, 0x52, 0xad, 0x4b, 0x20, 0x43, 0xd9, 0x92 // V4 0b00 Medium ECL
+#define QRTINY_ECC_DIVISORS_LOW      0x98, 0xb9, 0xf0, 0x05, 0x6f, 0x63, 0x06, 0xdc, 0x70, 0x96, 0x45, 0x24, 0xbb, 0x16, 0xe4, 0xc6, 0x79, 0x79, 0xa5, 0xae // V4 0b01 Low ECL
+#define QRTINY_ECC_DIVISORS_HIGH     0x3b, 0x0d, 0x68, 0xbd, 0x44, 0xd1, 0x1e, 0x08, 0xa3, 0x41, 0x29, 0xe5, 0x62, 0x32, 0x24, 0x3b // V4 0b10 High ECL
+#define QRTINY_ECC_DIVISORS_QUARTILE 0xf6, 0x33, 0xb7, 0x04, 0x88, 0x62, 0xc7, 0x98, 0x4d, 0x38, 0xce, 0x18, 0x91, 0x28, 0xd1, 0x75, 0xe9, 0x2a, 0x87, 0x44, 0x46, 0x90, 0x92, 0x4d, 0x2b, 0x5e // V4 0b11 Quartile ECL
+#endif
+
+// Segment modes (as encoded in the mode indicator)
+#define QRTINY_MODE_NUMERIC      0x1
+#define QRTINY_MODE_ALPHANUMERIC 0x2
+#define QRTINY_MODE_8BIT         0x4
+
 // Encode one or more segments of text to the buffer (at bit offset specified), returning the number of bits written. Caller must ensure buffer has capacity.
 size_t QrTinyWriteNumeric(void *buffer, size_t offset, const char *text);       // 17-41 digits, depending on ECC.
 size_t QrTinyWriteAlphanumeric(void *buffer, size_t offset, const char *text);  // 10-26 characters (upper-case/digits/symbols), depending on ECC.
 size_t QrTinyWrite8Bit(void *buffer, size_t offset, const char *text);          //  7-17 8-bit characters, depending on ECC.
 
-// Compute the remaining buffer contents: any required padding and the calculated error-correction information
+// As above, for a given length of data rather than a null-terminated string (8-bit data may include null bytes).
+size_t QrTinyWriteNumericN(void *buffer, size_t offset, const char *data, size_t length);
+size_t QrTinyWriteAlphanumericN(void *buffer, size_t offset, const char *data, size_t length);
+size_t QrTinyWrite8BitN(void *buffer, size_t offset, const char *data, size_t length);
+
+// A plan of segments for encoding text in the fewest bits.  The shortest segment (a single digit) is 4 + 10 + 4 bits, so a plan
+// that fits at the lowest error-correction level has at most this many segments (8 for V1).  A smaller limit may be defined to
+// save memory, in which case a plan that would need more segments encodes the start of the text as a single 8-bit segment.
+#ifndef QRTINY_PLAN_SEGMENTS_MAX
+#define QRTINY_PLAN_SEGMENTS_MAX ((QRTINY_TOTAL_CAPACITY / 8 - QRTINY_ECC_CODEWORDS_MIN) * 8 / 18)
+#endif
+typedef struct
+{
+    uint8_t mode;           // QRTINY_MODE_*
+    uint8_t length;         // Number of characters
+} qrtiny_segment_t;
+
+typedef struct
+{
+    qrtiny_segment_t segments[QRTINY_PLAN_SEGMENTS_MAX];
+    int segmentCount;
+    size_t bits;            // Total payload length in bits
+    int ecl;                // Strongest error-correction level (QRTINY_ECL_*) with the capacity for the payload
+} qrtiny_plan_t;
+
+// Plan the segment modes to encode the text in the fewest bits (within QRTINY_PLAN_SEGMENTS_MAX segments), returning false only if
+// it cannot fit at any error-correction level.
+bool QrTinyPlan(const char *text, size_t length, qrtiny_plan_t *plan);
+// Encode the text to the buffer (at bit offset specified) as planned, returning the number of bits written.
+size_t QrTinyPlanWrite(void *buffer, size_t offset, const char *text, const qrtiny_plan_t *plan);
+
+// Compute the remaining buffer contents: any required padding and the calculated error-correction information (the error-correction
+// codewords of each block in turn, after all of the data codewords; the blocks are interleaved only when placed in the symbol)
 bool QrTinyGenerate(uint8_t *buffer, size_t payloadLength, uint16_t formatInfo);
 
+// Generate a batch of buffers with the same format info (each with its own payload length, as for QrTinyGenerate()).  Where the
+// processor supports it (SSSE3/AVX2), the error-correction codewords of up to 16/32 buffers are calculated together.
+// Returns false, without changing any buffer, if any payload does not fit.
+bool QrTinyGenerateBatch(uint8_t *const buffers[], const size_t payloadLengths[], size_t count, uint16_t formatInfo);
+
 // Get the module at the given coordinate (0=light, 1=dark)
-int QrTinyModuleGet(uint8_t *buffer, uint16_t formatInfo, int x, int y);
+int QrTinyModuleGet(const uint8_t *buffer, uint16_t formatInfo, int x, int y);
+
+// Get a whole row, y from -quiet to QRTINY_DIMENSION + quiet - 1, with a quiet margin of 0 to QRTINY_QUIET_STANDARD modules (bit
+// quiet + x is the module at (x, y), 0=light, 1=dark; 0 for an invalid margin).  As for QrTinyModuleGet(), there are no tables or
+// state beyond the buffer, but the function patterns, format info and mask pattern are worked out once for the row.
+qrtiny_quiet_row_t QrTinyRowGet(const uint8_t *buffer, uint16_t formatInfo, int y, int quiet);
+
+// Fast mode: render the whole symbol to packed rows (bit x of rows[y] is the module at (x, y), 0=light, 1=dark) using precomputed tables
+void QrTinyRender(const uint8_t *buffer, uint16_t formatInfo, qrtiny_row_t rows[QRTINY_DIMENSION]);
+
+// Pixel formats for QrTinyBlit()
+#define QRTINY_PIXEL_1BPP_MSB 0     // 1 bit per pixel (1=dark), packed with the first pixel in the most-significant bit of each byte
+#define QRTINY_PIXEL_1BPP_LSB 1     // 1 bit per pixel (1=dark), packed with the first pixel in the least-significant bit of each byte
+#define QRTINY_PIXEL_8BPP     2     // 8 bits per pixel, 0x00=dark, 0xff=light
+#define QRTINY_PIXEL_RGB565   3     // 16 bits per pixel, 0x0000=dark, 0xffff=light
+
+// Draw the symbol (with a quiet margin of the given number of modules) into a caller-owned surface, each module as a scale x scale
+// block of pixels, light and dark swapped if inverted.  The drawn area is (QRTINY_DIMENSION + 2 * quiet) * scale pixels square, from
+// the first byte of dst, with stride bytes between the starts of pixel rows.  1 bpp bits beyond the area's width are unchanged.
+// Returns false for an invalid pixel format, scale or quiet margin.
+bool QrTinyBlit(const uint8_t *buffer, uint16_t formatInfo, void *dst, size_t stride, int pixelFormat, int scale, int quiet, bool invert);
+
+// A rectangle of modules
+typedef struct
+{
+    uint8_t x, y;
+    uint8_t width, height;
+} qrtiny_rect_t;
+
+// Find the regions of modules that differ between two symbols (e.g. for a partial display refresh): one rectangle for each run
+// of rows with the same span of changed columns, where the span covers the changed modules of the row.  Where more than maxRects
+// (at least 1) would be needed, neighbouring rectangles are merged, adding as few unchanged modules as possible, so the result
+// always covers every changed module.  Returns the number of rectangles (0 for identical symbols), or -1 if maxRects < 1.
+int QrTinyDiff(const uint8_t *oldBuffer, uint16_t oldFormatInfo, const uint8_t *newBuffer, uint16_t newFormatInfo, qrtiny_rect_t rects[], int maxRects);
+
+// Get the format info for an error-correction level (QRTINY_ECL_*) and mask pattern (0-7)
+uint16_t QrTinyFormatInfo(int ecl, int maskPattern);
+
+// Choose the mask pattern with the lowest penalty score for the generated buffer, returning the format info to use
+uint16_t QrTinyChooseMask(const uint8_t *buffer, int ecl);
+
+// Template for a run of codes that differ only in part of the payload (e.g. a trailing serial number): the generated codewords
+// and rendered symbol are kept, along with the error-correction contribution of each data codeword position, so that each
+// new code only updates the changed codewords and their modules.
+#define QRTINY_DATA_CODEWORDS_MAX ((QRTINY_TOTAL_CAPACITY / 8) - QRTINY_ECC_CODEWORDS_MIN)
+typedef struct
+{
+    uint8_t buffer[QRTINY_BUFFER_SIZE];     // Codewords: rewrite the changing part of the payload here, then call QrTinyTemplateUpdate()
+    uint8_t committed[QRTINY_BUFFER_SIZE];  // Codewords of the rendered symbol
+    qrtiny_row_t rows[QRTINY_DIMENSION];    // Rendered symbol, as for QrTinyRender()
+    uint16_t formatInfo;
+    int dataCodewords;                      // In total
+    int eccCodewords;                       // In each block
+    int blocks;
+    uint8_t eccContribution[QRTINY_DATA_CODEWORDS_MAX][QRTINY_ECC_CODEWORDS_MAX];   // Error-correction codewords of a block for a data codeword of 1 at each position of the block
+} qrtiny_template_t;
+
+// Initialize the template from a generated buffer (after QrTinyGenerate() with the same format info)
+void QrTinyTemplateInit(qrtiny_template_t *tmpl, const uint8_t *buffer, uint16_t formatInfo);
+// After rewriting payload bits in tmpl->buffer (the same segment lengths, from the bit offset given), update the error-correction codewords and rows.
+void QrTinyTemplateUpdate(qrtiny_template_t *tmpl, size_t offset, size_t bitCount);
+
+// Read the codewords from a rendered symbol (as for QrTinyRender()) to the buffer, with the format info, correcting any errors.
+// Returns the number of codewords corrected (0 for a clean symbol), or -1 if the symbol could not be read.
+int QrTinyVerify(const qrtiny_row_t rows[QRTINY_DIMENSION], uint8_t *buffer, uint16_t *formatInfo);
+// Parse the numeric, alphanumeric and 8-bit segments of a (verified) buffer back to null-terminated text, returning the length, or -1 if invalid or too long for the text size.
+int QrTinyDecode(const uint8_t *buffer, uint16_t formatInfo, char *text, size_t textSize);
+
+#ifdef QRTINY_STATS
+// Optional instrumentation (compile everything with QRTINY_STATS defined): per-phase call counts, total time and a histogram of
+// the time per call.  Time is in nanoseconds from a monotonic clock, unless QRTINY_STATS_CLOCK() is defined as an expression giving
+// another 64-bit count (e.g. a cycle counter), with QRTINY_STATS_CLOCK_UNITS naming its units.  Statistics are kept per thread.
+#ifndef QRTINY_STATS_CLOCK_UNITS
+#define QRTINY_STATS_CLOCK_UNITS "ns"
+#endif
+#define QRTINY_STATS_PLAN     0     // QrTinyPlan()
+#define QRTINY_STATS_WRITE    1     // Segment writing: QrTinyWrite*() (each segment written by QrTinyPlanWrite())
+#define QRTINY_STATS_PAD      2     // QrTinyGenerate(): terminator and padding
+#define QRTINY_STATS_ECC      3     // QrTinyGenerate(): error-correction codewords
+#define QRTINY_STATS_RENDER   4     // QrTinyRender() (including the one by QrTinyChooseMask())
+#define QRTINY_STATS_MASK     5     // QrTinyChooseMask()
+#define QRTINY_STATS_TEMPLATE 6     // QrTinyTemplateUpdate()
+#define QRTINY_STATS_VERIFY   7     // QrTinyVerify()
+#define QRTINY_STATS_PHASES   8
+#define QRTINY_STATS_BUCKETS 24     // Histogram bucket b counts calls taking 2^b to 2^(b+1)-1 (the first bucket includes 0, the last has no upper limit)
+
+typedef struct
+{
+    uint64_t calls;
+    uint64_t total;
+    uint64_t max;
+    uint64_t histogram[QRTINY_STATS_BUCKETS];
+} qrtiny_stats_phase_t;
+
+typedef struct
+{
+    qrtiny_stats_phase_t phases[QRTINY_STATS_PHASES];
+} qrtiny_stats_t;
+
+// Copy the calling thread's statistics
+void QrTinyStatsGet(qrtiny_stats_t *stats);
+// Clear the calling thread's statistics
+void QrTinyStatsReset(void);
+// Accumulate statistics (e.g. from each thread) to a total
+void QrTinyStatsAdd(qrtiny_stats_t *total, const qrtiny_stats_t *stats);
+// Name of a phase (QRTINY_STATS_*)
+const char *QrTinyStatsPhaseName(int phase);
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,494 @@
+// QR Code V1-V4 Generator - compile-time C++17 front-end
+// Dan Jackson, 2020
+//
+// Header-only: generates the symbol for a constant payload entirely at compile time, using the same tables as qrtiny.c,
+// to give the same result as the C path (planning, QrTinyGenerate(), QrTinyChooseMask(), QrTinyRender()).
+//
+//   static constexpr auto qr = qrtiny::make("HTTPS://X.DEV/ABC", qrtiny::Ecc::Medium, qrtiny::Mask::Auto);
+//   static constexpr auto qr = qrtiny::make<"HTTPS://X.DEV/ABC", qrtiny::Ecc::Medium, qrtiny::Mask::Auto>();  // C++20
+//
+//   qr.rows[y] >> x & 1, or qr.module(x, y)   // 0=light, 1=dark
+
+#ifndef QRTINY_HPP
+#define QRTINY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+#include "qrtiny.h"
+
+namespace qrtiny {
+
+// Error-correction level (Auto: the strongest that fits)
+enum class Ecc : int {
+    Medium = QRTINY_ECL_MEDIUM,
+    Low = QRTINY_ECL_LOW,
+    High = QRTINY_ECL_HIGH,
+    Quartile = QRTINY_ECL_QUARTILE,
+    Auto = -1,
+};
+
+// Mask pattern (Auto: the lowest penalty score)
+enum class Mask : int {
+    M000 = 0, M001 = 1, M010 = 2, M011 = 3, M100 = 4, M101 = 5, M110 = 6, M111 = 7,
+    Auto = -1,
+};
+
+// Generated symbol (of the version QRTINY_VERSION): bit x of rows[y] is the module at (x, y), 0=light, 1=dark
+struct Symbol {
+    std::array<qrtiny_row_t, QRTINY_DIMENSION> rows;
+    uint16_t formatInfo;
+
+    constexpr int module(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= QRTINY_DIMENSION || y >= QRTINY_DIMENSION) return 0;
+        return (int)((rows[(size_t)y] >> x) & 1);
+    }
+};
+
+namespace detail {
+
+constexpr int eclCount = 4;
+constexpr int maskCount = 8;
+constexpr size_t totalCodewords = QRTINY_TOTAL_CAPACITY / 8;
+constexpr int eccCodewordsMax = QRTINY_ECC_CODEWORDS_MAX;
+
+// Shared tables from qrtiny.h
+constexpr int8_t eccBlockCodewords[eclCount] = { QRTINY_ECC_BLOCK_CODEWORDS };
+constexpr int8_t eccBlocks[eclCount] = { QRTINY_ECC_BLOCKS };
+constexpr uint8_t eccDivisors[eclCount][eccCodewordsMax] = {
+    { QRTINY_ECC_DIVISORS_MEDIUM },
+    { QRTINY_ECC_DIVISORS_LOW },
+    { QRTINY_ECC_DIVISORS_HIGH },
+    { QRTINY_ECC_DIVISORS_QUARTILE },
+};
+constexpr uint16_t formatInfos[eclCount][maskCount] = {
+    { QRTINY_FORMATINFO_MASK_000_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_001_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_010_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_011_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_100_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_101_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_110_ECC_MEDIUM, QRTINY_FORMATINFO_MASK_111_ECC_MEDIUM },
+    { QRTINY_FORMATINFO_MASK_000_ECC_LOW, QRTINY_FORMATINFO_MASK_001_ECC_LOW, QRTINY_FORMATINFO_MASK_010_ECC_LOW, QRTINY_FORMATINFO_MASK_011_ECC_LOW, QRTINY_FORMATINFO_MASK_100_ECC_LOW, QRTINY_FORMATINFO_MASK_101_ECC_LOW, QRTINY_FORMATINFO_MASK_110_ECC_LOW, QRTINY_FORMATINFO_MASK_111_ECC_LOW },
+    { QRTINY_FORMATINFO_MASK_000_ECC_HIGH, QRTINY_FORMATINFO_MASK_001_ECC_HIGH, QRTINY_FORMATINFO_MASK_010_ECC_HIGH, QRTINY_FORMATINFO_MASK_011_ECC_HIGH, QRTINY_FORMATINFO_MASK_100_ECC_HIGH, QRTINY_FORMATINFO_MASK_101_ECC_HIGH, QRTINY_FORMATINFO_MASK_110_ECC_HIGH, QRTINY_FORMATINFO_MASK_111_ECC_HIGH },
+    { QRTINY_FORMATINFO_MASK_000_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_001_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_010_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_011_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_100_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_101_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_110_ECC_QUARTILE, QRTINY_FORMATINFO_MASK_111_ECC_QUARTILE },
+};
+
+// Not constexpr: reaching this during constant evaluation fails the compilation
+inline void payload_does_not_fit() { std::abort(); }
+
+constexpr size_t data_codewords(int ecl) { return totalCodewords - (size_t)eccBlockCodewords[ecl] * (size_t)eccBlocks[ecl]; }
+
+// --- Encoding ---
+constexpr int alphanumeric_value(char c)
+{
+    constexpr std::string_view symbols = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+    if (c >= 'a' && c <= 'z') c = (char)(c + 'A' - 'a');
+    size_t index = symbols.find(c);
+    return index == std::string_view::npos ? 0 : (int)index;
+}
+
+constexpr bool is_numeric(char c) { return c >= '0' && c <= '9'; }
+constexpr bool is_alphanumeric(char c) { return c != '\0' && std::string_view("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:").find(c) != std::string_view::npos; }
+
+struct Codewords {
+    std::array<uint8_t, QRTINY_BUFFER_SIZE> buffer{};
+    size_t position = 0;
+
+    constexpr void append(uint32_t value, int bitCount)
+    {
+        for (int i = bitCount - 1; i >= 0; i--, position++)
+        {
+            if ((value >> i) & 1) buffer[position >> 3] |= (uint8_t)(0x80 >> (position & 7));
+        }
+    }
+};
+
+struct Segment {
+    int mode = 0;
+    size_t length = 0;
+};
+
+struct Plan {
+    std::array<Segment, QRTINY_PLAN_SEGMENTS_MAX> segments{};
+    int segmentCount = 0;
+    size_t bits = 0;
+    int ecl = QRTINY_ECL_LOW;
+};
+
+constexpr size_t segment_bits(int mode, size_t count)
+{
+    switch (mode)
+    {
+        case QRTINY_MODE_NUMERIC: return 4 + 10 + 10 * (count / 3) + (count % 3) * 4 - (count % 3) / 2;
+        case QRTINY_MODE_ALPHANUMERIC: return 4 + 9 + 11 * (count >> 1) + 6 * (count & 1);
+        default: return 4 + 8 + 8 * count;
+    }
+}
+
+// As QrTinyPlan(): minimal-bit segmentation (costs in 1/6 bits), then the strongest error-correction level that fits
+constexpr Plan plan(std::string_view text)
+{
+    constexpr int modes[3] = { QRTINY_MODE_NUMERIC, QRTINY_MODE_ALPHANUMERIC, QRTINY_MODE_8BIT };
+    constexpr int characterCost[3] = { 20, 33, 48 };
+    constexpr int headerCost[3] = { 6 * (4 + 10), 6 * (4 + 9), 6 * (4 + 8) };
+    constexpr int unreachable = 0x7fffffff;
+    constexpr size_t lengthMax = ((totalCodewords - QRTINY_ECC_CODEWORDS_MIN) * 8 - 4 - 10) * 3 / 10;
+    Plan result;
+    if (text.size() > lengthMax) { payload_does_not_fit(); return result; }
+
+    int cost[3] = { headerCost[0], headerCost[1], headerCost[2] };
+    uint8_t from[lengthMax > 0 ? lengthMax : 1][3] = {};
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        int next[3] = {};
+        for (int j = 0; j < 3; j++)
+        {
+            bool possible = j == 0 ? is_numeric(text[i]) : j == 1 ? is_alphanumeric(text[i]) : true;
+            next[j] = possible ? cost[j] + characterCost[j] : unreachable;
+            from[i][j] = (uint8_t)j;
+        }
+        for (int j = 0; j < 3; j++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                if (next[k] == unreachable || k == j) continue;
+                int switched = (next[k] + 5) / 6 * 6 + headerCost[j];
+                if (switched < next[j])
+                {
+                    next[j] = switched;
+                    from[i][j] = (uint8_t)k;
+                }
+            }
+        }
+        for (int j = 0; j < 3; j++) cost[j] = next[j];
+    }
+
+    int mode = 0;
+    for (int j = 1; j < 3; j++)
+    {
+        if (cost[j] < cost[mode]) mode = j;
+    }
+    int currentSegmentMode = -1;
+    for (size_t i = text.size(); i-- > 0; )
+    {
+        mode = from[i][mode];
+        if (mode != currentSegmentMode)
+        {
+            if ((size_t)result.segmentCount >= QRTINY_PLAN_SEGMENTS_MAX)
+            {
+                result.segments[(size_t)result.segmentCount - 1].mode = QRTINY_MODE_8BIT;
+                result.segments[(size_t)result.segmentCount - 1].length += i + 1;
+                if (result.segmentCount > 1 && result.segments[(size_t)result.segmentCount - 2].mode == QRTINY_MODE_8BIT)
+                {
+                    result.segments[(size_t)result.segmentCount - 2].length += result.segments[(size_t)result.segmentCount - 1].length;
+                    result.segmentCount--;
+                }
+                break;
+            }
+            result.segments[(size_t)result.segmentCount] = Segment{ modes[mode], 0 };
+            result.segmentCount++;
+            currentSegmentMode = mode;
+        }
+        result.segments[(size_t)result.segmentCount - 1].length++;
+    }
+    for (int i = 0; i < result.segmentCount / 2; i++)
+    {
+        Segment swap = result.segments[(size_t)i];
+        result.segments[(size_t)i] = result.segments[(size_t)(result.segmentCount - 1 - i)];
+        result.segments[(size_t)(result.segmentCount - 1 - i)] = swap;
+    }
+    for (int i = 0; i < result.segmentCount; i++)
+    {
+        result.bits += segment_bits(result.segments[(size_t)i].mode, result.segments[(size_t)i].length);
+    }
+    if (result.bits > segment_bits(QRTINY_MODE_8BIT, text.size()))
+    {
+        result.segments[0] = Segment{ QRTINY_MODE_8BIT, text.size() };
+        result.segmentCount = 1;
+        result.bits = segment_bits(QRTINY_MODE_8BIT, text.size());
+    }
+
+    constexpr int eclStrongest[eclCount] = { QRTINY_ECL_HIGH, QRTINY_ECL_QUARTILE, QRTINY_ECL_MEDIUM, QRTINY_ECL_LOW };
+    for (int i = 0; i < eclCount; i++)
+    {
+        if (result.bits <= data_codewords(eclStrongest[i]) * 8)
+        {
+            result.ecl = eclStrongest[i];
+            return result;
+        }
+    }
+    payload_does_not_fit();
+    return result;
+}
+
+constexpr void write(Codewords &codewords, std::string_view text, const Plan &plan)
+{
+    size_t offset = 0;
+    for (int s = 0; s < plan.segmentCount; s++)
+    {
+        const Segment &segment = plan.segments[(size_t)s];
+        std::string_view data = text.substr(offset, segment.length);
+        offset += segment.length;
+        codewords.append((uint32_t)segment.mode, 4);
+        if (segment.mode == QRTINY_MODE_NUMERIC)
+        {
+            codewords.append((uint32_t)data.size(), 10);
+            size_t i = 0;
+            for (; i + 3 <= data.size(); i += 3) codewords.append((uint32_t)((data[i] - '0') * 100 + (data[i + 1] - '0') * 10 + (data[i + 2] - '0')), 10);
+            if (data.size() - i == 2) codewords.append((uint32_t)((data[i] - '0') * 10 + (data[i + 1] - '0')), 7);
+            else if (data.size() - i == 1) codewords.append((uint32_t)(data[i] - '0'), 4);
+        }
+        else if (segment.mode == QRTINY_MODE_ALPHANUMERIC)
+        {
+            codewords.append((uint32_t)data.size(), 9);
+            size_t i = 0;
+            for (; i + 2 <= data.size(); i += 2) codewords.append((uint32_t)(alphanumeric_value(data[i]) * 45 + alphanumeric_value(data[i + 1])), 11);
+            if (i < data.size()) codewords.append((uint32_t)alphanumeric_value(data[i]), 6);
+        }
+        else
+        {
+            codewords.append((uint32_t)data.size(), 8);
+            for (char c : data) codewords.append((uint8_t)c, 8);
+        }
+    }
+}
+
+// As QrTinyGenerate(): terminator, padding, and error-correction codewords (of each block in turn, after the data codewords)
+constexpr void generate(Codewords &codewords, int ecl)
+{
+    int eccCodewords = eccBlockCodewords[ecl];
+    size_t dataCapacity = data_codewords(ecl) * 8;
+    size_t remaining = dataCapacity - codewords.position;
+    codewords.append(0, (int)(remaining > 4 ? 4 : remaining));
+    remaining = dataCapacity - codewords.position;
+    size_t bits = (8 - (codewords.position & 7)) & 7;
+    codewords.append(0, (int)(remaining > bits ? bits : remaining));
+    while ((remaining = dataCapacity - codewords.position) > 0)
+    {
+        if (remaining > 16) remaining = 16;
+        codewords.append(0xec11 >> (16 - remaining), (int)remaining);
+    }
+
+    // Reed-Solomon remainder of each block, bit-wise product modulo GF(2^8/0x011D)
+    const uint8_t *generator = eccDivisors[ecl];
+    size_t blockData = dataCapacity / 8 / (size_t)eccBlocks[ecl];
+    for (int block = 0; block < eccBlocks[ecl]; block++)
+    {
+        uint8_t result[eccCodewordsMax] = {};
+        for (size_t i = 0; i < blockData; i++)
+        {
+            uint8_t factor = (uint8_t)(codewords.buffer[(size_t)block * blockData + i] ^ result[0]);
+            for (int j = 0; j < eccCodewords - 1; j++) result[j] = result[j + 1];
+            result[eccCodewords - 1] = 0;
+            for (int j = 0; j < eccCodewords; j++)
+            {
+                uint8_t value = 0;
+                for (int k = 7; k >= 0; k--)
+                {
+                    value = (uint8_t)((value << 1) ^ ((value >> 7) * 0x011D));
+                    value ^= (uint8_t)(((factor >> k) & 1) * generator[j]);
+                }
+                result[j] ^= value;
+            }
+        }
+        for (int j = 0; j < eccCodewords; j++) codewords.buffer[dataCapacity / 8 + (size_t)(block * eccCodewords + j)] = result[j];
+    }
+}
+
+// --- Rendering (as QrTinyModuleGet()) ---
+constexpr int finderSize = 7;
+constexpr int timingOffset = 6;
+constexpr int alignmentOffset = 6;
+
+constexpr int abs_value(int v) { return v < 0 ? -v : v; }
+
+// 0=light, 1=dark, -1=data
+constexpr int identify_module(int x, int y, uint16_t formatInfo)
+{
+    for (int f = 0; f < 3; f++)
+    {
+        int dx = abs_value(x - (f & 1 ? QRTINY_DIMENSION - 1 - finderSize / 2 : finderSize / 2));
+        int dy = abs_value(y - (f & 2 ? QRTINY_DIMENSION - 1 - finderSize / 2 : finderSize / 2));
+        if (dx == 0 && dy == 0) return 1;
+        if (dx <= 1 + finderSize / 2 && dy <= 1 + finderSize / 2) return ((dx > dy ? dx : dy) & 1) ? 1 : 0;
+    }
+    if (x == timingOffset || y == timingOffset) return ((x ^ y) & 1) ? 0 : 1;
+    int ax = abs_value(x - (QRTINY_DIMENSION - 1 - alignmentOffset));
+    int ay = abs_value(y - (QRTINY_DIMENSION - 1 - alignmentOffset));
+    if (QRTINY_VERSION > 1 && ax <= 2 && ay <= 2) return (ax > ay ? ax : ay) == 1 ? 0 : 1;
+    int xx = x - ((x >= timingOffset) ? 1 : 0);
+    int yy = y - ((y >= timingOffset) ? 1 : 0);
+    if (x == finderSize + 1 && y == QRTINY_DIMENSION - finderSize - 1) return 1;
+    int formatIndex = -1;
+    if (xx <= finderSize && yy <= finderSize) formatIndex = 7 - xx + yy;
+    if (x == finderSize + 1 && y >= QRTINY_DIMENSION - finderSize - 1) formatIndex = y + 14 - (QRTINY_DIMENSION - 1);
+    if (y == finderSize + 1 && x >= QRTINY_DIMENSION - finderSize - 1) formatIndex = QRTINY_DIMENSION - 1 - x;
+    if (formatIndex >= 0) return (formatInfo >> formatIndex) & 1;
+    return -1;
+}
+
+// Data bit index of each data module (codeword * 8 + bit, least-significant first, for the codewords in the order placed), in the
+// order of the two-module columns from the right, upwards and downwards in turn, and the right-hand module of each row first
+constexpr std::array<std::array<int16_t, QRTINY_DIMENSION>, QRTINY_DIMENSION> make_placement()
+{
+    std::array<std::array<int16_t, QRTINY_DIMENSION>, QRTINY_DIMENSION> placement{};
+    int index = 0;
+    for (int right = QRTINY_DIMENSION - 1, pair = 0; right > 0; right -= (right == timingOffset + 2) ? 3 : 2, pair++)
+    {
+        for (int row = 0; row < QRTINY_DIMENSION; row++)
+        {
+            int y = (pair & 1) ? row : QRTINY_DIMENSION - 1 - row;
+            for (int x = right; x >= right - 1; x--)
+            {
+                if (identify_module(x, y, 0) < 0) placement[(size_t)y][(size_t)x] = (int16_t)(index++ ^ 7);
+            }
+        }
+    }
+    return placement;
+}
+
+constexpr auto placement = make_placement();
+
+// Buffer codeword at a position of the codewords in the order placed, where the blocks are interleaved
+constexpr size_t codeword_index(size_t position, int ecl)
+{
+    size_t blocks = (size_t)eccBlocks[ecl];
+    size_t dataCodewords = data_codewords(ecl);
+    size_t start = (position < dataCodewords) ? 0 : dataCodewords;
+    size_t blockLength = (position < dataCodewords) ? dataCodewords / blocks : (size_t)eccBlockCodewords[ecl];
+    return start + ((position - start) % blocks) * blockLength + (position - start) / blocks;
+}
+
+constexpr bool calculate_mask(int maskPattern, int j, int i)
+{
+    switch (maskPattern)
+    {
+        case 0: return ((i + j) & 1) == 0;
+        case 1: return (i & 1) == 0;
+        case 2: return j % 3 == 0;
+        case 3: return (i + j) % 3 == 0;
+        case 4: return (((i >> 1) + (j / 3)) & 1) == 0;
+        case 5: return ((i * j) & 1) + ((i * j) % 3) == 0;
+        case 6: return ((((i * j) & 1) + ((i * j) % 3)) & 1) == 0;
+        case 7: return ((((i * j) % 3) + ((i + j) & 1)) & 1) == 0;
+        default: return false;
+    }
+}
+
+constexpr std::array<qrtiny_row_t, QRTINY_DIMENSION> render(const Codewords &codewords, uint16_t formatInfo)
+{
+    int ecl = ((formatInfo ^ 0x5412) >> 13) & 3;
+    int maskPattern = ((formatInfo ^ 0x5412) >> 10) & 7;
+    std::array<qrtiny_row_t, QRTINY_DIMENSION> rows{};
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        for (int x = 0; x < QRTINY_DIMENSION; x++)
+        {
+            int type = identify_module(x, y, formatInfo);
+            if (type < 0)
+            {
+                size_t index = (size_t)placement[(size_t)y][(size_t)x];
+                type = (index >> 3) < totalCodewords ? (codewords.buffer[codeword_index(index >> 3, ecl)] >> (index & 7)) & 1 : 0;    // Remainder bits are 0
+                if (calculate_mask(maskPattern, x, y)) type ^= 1;
+            }
+            rows[(size_t)y] |= (qrtiny_row_t)type << x;
+        }
+    }
+    return rows;
+}
+
+// --- Mask selection (as QrTinyChooseMask()) ---
+constexpr int bit_count(uint64_t value)
+{
+    int count = 0;
+    for (; value; value &= value - 1) count++;
+    return count;
+}
+
+constexpr uint64_t line_bits(int n) { return ((uint64_t)1 << n) - 1; }
+
+constexpr int penalty_line(uint64_t line)
+{
+    uint64_t same = ~(line ^ (line >> 1)) & line_bits(QRTINY_DIMENSION - 1);
+    uint64_t five = same & (same >> 1) & (same >> 2) & (same >> 3);
+    int penalty = bit_count(five) + 2 * bit_count(five & ~(five << 1));
+    uint64_t dark = line << 4;
+    uint64_t light = ~dark & line_bits(QRTINY_DIMENSION + 8);
+    uint64_t core = dark & (light >> 1) & (dark >> 2) & (dark >> 3) & (dark >> 4) & (light >> 5) & (dark >> 6);
+    uint64_t after = core & (light >> 7) & (light >> 8) & (light >> 9) & (light >> 10);
+    uint64_t before = core & (light << 1) & (light << 2) & (light << 3) & (light << 4);
+    return penalty + 40 * (bit_count(after) + bit_count(before));
+}
+
+constexpr int penalty(const std::array<qrtiny_row_t, QRTINY_DIMENSION> &rows)
+{
+    int result = 0;
+    int dark = 0;
+    for (int i = 0; i < QRTINY_DIMENSION; i++)
+    {
+        uint64_t column = 0;
+        for (int y = 0; y < QRTINY_DIMENSION; y++) column |= (uint64_t)((rows[(size_t)y] >> i) & 1) << y;
+        result += penalty_line(rows[(size_t)i]) + penalty_line(column);
+        dark += bit_count(rows[(size_t)i]);
+    }
+    for (int y = 0; y < QRTINY_DIMENSION - 1; y++)
+    {
+        uint64_t a = rows[(size_t)y], b = rows[(size_t)y + 1];
+        uint64_t blocks = ((a & (a >> 1) & b & (b >> 1)) | ~(a | (a >> 1) | b | (b >> 1))) & line_bits(QRTINY_DIMENSION - 1);
+        result += 3 * bit_count(blocks);
+    }
+    int total = QRTINY_DIMENSION * QRTINY_DIMENSION;
+    result += 10 * ((abs_value(dark * 20 - total * 10) + total - 1) / total - 1);
+    return result;
+}
+
+} // namespace detail
+
+// Generate the symbol for the text; use in a constant expression (e.g. to initialize a constexpr variable) to generate at compile time.
+// If the text does not fit, compilation fails (in a constant expression), or the program aborts.
+constexpr Symbol make(std::string_view text, Ecc ecc = Ecc::Auto, Mask mask = Mask::Auto)
+{
+    detail::Plan plan = detail::plan(text);
+    int ecl = ecc == Ecc::Auto ? plan.ecl : (int)ecc;
+    if (plan.bits > detail::data_codewords(ecl) * 8) detail::payload_does_not_fit();
+
+    detail::Codewords codewords;
+    detail::write(codewords, text, plan);
+    detail::generate(codewords, ecl);
+
+    Symbol symbol{};
+    int bestPenalty = -1;
+    for (int maskPattern = 0; maskPattern < detail::maskCount; maskPattern++)
+    {
+        if (mask != Mask::Auto && maskPattern != (int)mask) continue;
+        uint16_t formatInfo = detail::formatInfos[ecl][maskPattern];
+        std::array<qrtiny_row_t, QRTINY_DIMENSION> rows = detail::render(codewords, formatInfo);
+        int penalty = mask == Mask::Auto ? detail::penalty(rows) : 0;
+        if (bestPenalty < 0 || penalty < bestPenalty)
+        {
+            bestPenalty = penalty;
+            symbol.rows = rows;
+            symbol.formatInfo = formatInfo;
+        }
+    }
+    return symbol;
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+// C++20: text as a template argument, e.g. qrtiny::make<"HELLO", qrtiny::Ecc::Medium>()
+template<size_t N>
+struct FixedString {
+    char data[N] = {};
+    constexpr FixedString(const char (&text)[N]) { for (size_t i = 0; i < N; i++) data[i] = text[i]; }
+    constexpr std::string_view view() const { return std::string_view(data, N - 1); }
+};
+
+template<FixedString Text, Ecc E = Ecc::Auto, Mask M = Mask::Auto>
+inline constexpr Symbol symbol = make(Text.view(), E, M);
+
+template<FixedString Text, Ecc E = Ecc::Auto, Mask M = Mask::Auto>
+constexpr const Symbol &make() { return symbol<Text, E, M>; }
+#endif
+
+} // namespace qrtiny
+
+#endif
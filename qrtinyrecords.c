@@ -0,0 +1,252 @@
+// QR Code V1-V4 Generator - Binary record files
+// Dan Jackson, 2020
+
+#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS
+#include <windows.h>
+#else
+#define _POSIX_C_SOURCE 200112L
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "qrtinyrecords.h"
+
+// Records are a fixed size (32 bytes for V1)
+typedef char qrtiny_record_size_check_t[(sizeof(qrtiny_record_t) == QRTINY_BUFFER_SIZE + 6) ? 1 : -1];
+
+static void QrTinyRecordsPut16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void QrTinyRecordsPut32(uint8_t *p, uint32_t value)
+{
+    QrTinyRecordsPut16(p, (uint16_t)value);
+    QrTinyRecordsPut16(p + 2, (uint16_t)(value >> 16));
+}
+
+static void QrTinyRecordsPut64(uint8_t *p, uint64_t value)
+{
+    QrTinyRecordsPut32(p, (uint32_t)value);
+    QrTinyRecordsPut32(p + 4, (uint32_t)(value >> 32));
+}
+
+static uint16_t QrTinyRecordsGet16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t QrTinyRecordsGet32(const uint8_t *p)
+{
+    return (uint32_t)QrTinyRecordsGet16(p) | ((uint32_t)QrTinyRecordsGet16(p + 2) << 16);
+}
+
+static uint64_t QrTinyRecordsGet64(const uint8_t *p)
+{
+    return (uint64_t)QrTinyRecordsGet32(p) | ((uint64_t)QrTinyRecordsGet32(p + 4) << 32);
+}
+
+uint32_t QrTinyRecordHash(const char *text, size_t length)
+{
+    uint32_t hash = 0x811c9dc5;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ (uint8_t)text[i]) * 0x01000193;
+    }
+    return hash;
+}
+
+void QrTinyRecordMake(qrtiny_record_t *record, const uint8_t *buffer, uint16_t formatInfo, const char *text, size_t length)
+{
+    memcpy(record->buffer, buffer, sizeof(record->buffer));
+    QrTinyRecordsPut16(record->formatInfo, formatInfo);
+    QrTinyRecordsPut32(record->hash, QrTinyRecordHash(text, length));
+}
+
+uint16_t QrTinyRecordFormatInfo(const qrtiny_record_t *record)
+{
+    return QrTinyRecordsGet16(record->formatInfo);
+}
+
+// --- Writing ---
+static bool QrTinyRecordsWriteHeader(qrtiny_records_writer_t *writer, uint64_t indexOffset)
+{
+    uint8_t header[QRTINY_RECORDS_HEADER_SIZE] = { 0 };
+    memcpy(header, QRTINY_RECORDS_MAGIC, 8);
+    QrTinyRecordsPut16(header + 8, QRTINY_RECORDS_VERSION);
+    QrTinyRecordsPut16(header + 10, (uint16_t)sizeof(qrtiny_record_t));
+    QrTinyRecordsPut32(header + 12, (indexOffset ? QRTINY_RECORDS_FLAG_INDEX : 0) | ((QRTINY_VERSION - 1) << QRTINY_RECORDS_FLAG_VERSION_SHIFT));
+    QrTinyRecordsPut64(header + 16, writer->count);
+    QrTinyRecordsPut64(header + 24, indexOffset);
+    return fwrite(header, 1, sizeof(header), writer->fp) == sizeof(header);
+}
+
+bool QrTinyRecordsWriterOpen(qrtiny_records_writer_t *writer, FILE *fp, bool index)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->fp = fp;
+    writer->index = index;
+    // Header placeholder, completed on closing
+    return QrTinyRecordsWriteHeader(writer, 0);
+}
+
+bool QrTinyRecordsWriterAppend(qrtiny_records_writer_t *writer, const qrtiny_record_t *records, size_t count)
+{
+    if (writer->failed) return false;
+    if (writer->index)
+    {
+        if (writer->count + count > UINT32_MAX) { writer->failed = true; return false; }    // Record numbers in the index are 32-bit
+        if (writer->count + count > writer->capacity)
+        {
+            size_t capacity = writer->capacity ? writer->capacity : 4096;
+            while (capacity < writer->count + count) capacity *= 2;
+            uint64_t *entries = (uint64_t *)realloc(writer->entries, capacity * sizeof(uint64_t));
+            if (entries == NULL) { writer->failed = true; return false; }
+            writer->entries = entries;
+            writer->capacity = capacity;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            writer->entries[writer->count + i] = ((uint64_t)QrTinyRecordsGet32(records[i].hash) << 32) | (writer->count + i);
+        }
+    }
+    writer->count += count;
+    if (fwrite(records, sizeof(qrtiny_record_t), count, writer->fp) != count) writer->failed = true;
+    return !writer->failed;
+}
+
+static int QrTinyRecordsCompare(const void *a, const void *b)
+{
+    uint64_t valueA = *(const uint64_t *)a, valueB = *(const uint64_t *)b;
+    return (valueA > valueB) - (valueA < valueB);
+}
+
+bool QrTinyRecordsWriterClose(qrtiny_records_writer_t *writer)
+{
+    bool result = !writer->failed;
+    uint64_t indexOffset = 0;
+    if (writer->index)
+    {
+        indexOffset = QRTINY_RECORDS_HEADER_SIZE + writer->count * sizeof(qrtiny_record_t);
+        qsort(writer->entries, (size_t)writer->count, sizeof(uint64_t), QrTinyRecordsCompare);
+        for (uint64_t i = 0; i < writer->count && result; i++)
+        {
+            uint8_t entry[8];
+            QrTinyRecordsPut64(entry, writer->entries[i]);
+            result = fwrite(entry, 1, sizeof(entry), writer->fp) == sizeof(entry);
+        }
+    }
+    free(writer->entries);
+    writer->entries = NULL;
+
+    // Complete the header
+    result = result && fseek(writer->fp, 0, SEEK_SET) == 0 && QrTinyRecordsWriteHeader(writer, indexOffset) && fflush(writer->fp) == 0;
+    return result;
+}
+
+// --- Reading ---
+bool QrTinyRecordsOpen(qrtiny_records_t *records, const char *filename)
+{
+    memset(records, 0, sizeof(*records));
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) return false;
+    records->data = (const uint8_t *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (records->data == NULL) { CloseHandle(mapping); return false; }
+    records->mapping = mapping;
+    records->size = (size_t)size.QuadPart;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void *data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    records->data = (const uint8_t *)data;
+    records->size = (size_t)st.st_size;
+#endif
+
+    // Validate the header, records and index
+    const uint8_t *header = records->data;
+    bool valid = records->size >= QRTINY_RECORDS_HEADER_SIZE && memcmp(header, QRTINY_RECORDS_MAGIC, 8) == 0 && QrTinyRecordsGet16(header + 8) == QRTINY_RECORDS_VERSION;
+    if (valid)
+    {
+        records->recordSize = QrTinyRecordsGet16(header + 10);
+        records->count = QrTinyRecordsGet64(header + 16);
+        uint64_t indexOffset = QrTinyRecordsGet64(header + 24);
+        uint64_t available = (records->size - QRTINY_RECORDS_HEADER_SIZE) / (records->recordSize ? records->recordSize : 1);
+        uint32_t flags = QrTinyRecordsGet32(header + 12);
+        valid = records->recordSize >= sizeof(qrtiny_record_t) && records->count <= available && ((flags & QRTINY_RECORDS_FLAG_VERSION_MASK) >> QRTINY_RECORDS_FLAG_VERSION_SHIFT) == QRTINY_VERSION - 1;
+        if (valid && (flags & QRTINY_RECORDS_FLAG_INDEX))
+        {
+            valid = indexOffset >= QRTINY_RECORDS_HEADER_SIZE && indexOffset <= records->size && (records->size - indexOffset) / 8 >= records->count;
+            records->index = records->data + indexOffset;
+        }
+    }
+    if (!valid)
+    {
+        QrTinyRecordsClose(records);
+        return false;
+    }
+    return true;
+}
+
+void QrTinyRecordsClose(qrtiny_records_t *records)
+{
+    if (records->data == NULL) return;
+#ifdef _WIN32
+    UnmapViewOfFile(records->data);
+    CloseHandle((HANDLE)records->mapping);
+#else
+    munmap((void *)records->data, records->size);
+#endif
+    memset(records, 0, sizeof(*records));
+}
+
+const qrtiny_record_t *QrTinyRecordsGet(const qrtiny_records_t *records, uint64_t n)
+{
+    if (n >= records->count) return NULL;
+    return (const qrtiny_record_t *)(records->data + QRTINY_RECORDS_HEADER_SIZE + n * records->recordSize);
+}
+
+int64_t QrTinyRecordsFind(const qrtiny_records_t *records, const char *text, size_t length)
+{
+    if (records->index == NULL) return -1;
+    uint32_t hash = QrTinyRecordHash(text, length);
+
+    // First index entry with the hash
+    uint64_t low = 0, high = records->count;
+    while (low < high)
+    {
+        uint64_t middle = low + (high - low) / 2;
+        if ((QrTinyRecordsGet64(records->index + middle * 8) >> 32) < hash) low = middle + 1;
+        else high = middle;
+    }
+
+    // Confirm each record with the hash by decoding its payload
+    for (; low < records->count; low++)
+    {
+        uint64_t entry = QrTinyRecordsGet64(records->index + low * 8);
+        if ((entry >> 32) != hash) break;
+        const qrtiny_record_t *record = QrTinyRecordsGet(records, entry & 0xffffffff);
+        char decoded[QRTINY_BUFFER_SIZE * 2];
+        if (record != NULL && QrTinyDecode(record->buffer, QrTinyRecordFormatInfo(record), decoded, sizeof(decoded)) == (int)length && memcmp(decoded, text, length) == 0)
+        {
+            return (int64_t)(entry & 0xffffffff);
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,94 @@
+// QR Code V1-V4 Generator - Binary record files
+// Dan Jackson, 2020
+//
+// A fixed-stride file of generated symbols, to be memory-mapped and randomly accessed without parsing or regenerating.
+// All values are little-endian.
+//
+//   Header (32 bytes)
+//     0  char[8]   magic "QRTINYR1"
+//     8  uint16    version (1)
+//    10  uint16    recordSize: stride of the records (32 for V1 symbols, QRTINY_BUFFER_SIZE + 6 in general)
+//    12  uint32    flags: bit 0 set if there is an index; bits 8-15 the symbol version (QRTINY_VERSION) - 1
+//    16  uint64    count of records
+//    24  uint64    indexOffset: file offset of the index (0 if none)
+//   Records (count x recordSize bytes, from offset 32)
+//     0  uint8[26] buffer: the generated codewords, as for QrTinyModuleGet()/QrTinyRender() (QRTINY_BUFFER_SIZE bytes)
+//    26  uint16    formatInfo
+//    28  uint32    hash: 32-bit FNV-1a of the payload text
+//
+// The offsets shown are for V1; a file can only be opened by a build for the same symbol version.
+//   Index (count x 8 bytes, optional)
+//     0  uint64    (hash << 32) | record number, in ascending order
+
+#ifndef QRTINY_RECORDS_H
+#define QRTINY_RECORDS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "qrtiny.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define QRTINY_RECORDS_MAGIC "QRTINYR1"
+#define QRTINY_RECORDS_VERSION 1
+#define QRTINY_RECORDS_HEADER_SIZE 32
+#define QRTINY_RECORDS_FLAG_INDEX 0x0001
+#define QRTINY_RECORDS_FLAG_VERSION_SHIFT 8
+#define QRTINY_RECORDS_FLAG_VERSION_MASK 0xff00
+
+typedef struct
+{
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+    uint8_t formatInfo[2];
+    uint8_t hash[4];
+} qrtiny_record_t;
+
+// 32-bit FNV-1a hash of the payload text
+uint32_t QrTinyRecordHash(const char *text, size_t length);
+// Fill a record from a generated buffer, its format info, and the payload text
+void QrTinyRecordMake(qrtiny_record_t *record, const uint8_t *buffer, uint16_t formatInfo, const char *text, size_t length);
+// Format info of a record
+uint16_t QrTinyRecordFormatInfo(const qrtiny_record_t *record);
+
+// Writing a record file (to a seekable file, as the header is completed on closing)
+typedef struct
+{
+    FILE *fp;
+    uint64_t count;
+    bool index;
+    uint64_t *entries;      // Index entries, sorted on closing
+    size_t capacity;
+    bool failed;            // Any write failed (reported on closing)
+} qrtiny_records_writer_t;
+
+bool QrTinyRecordsWriterOpen(qrtiny_records_writer_t *writer, FILE *fp, bool index);
+bool QrTinyRecordsWriterAppend(qrtiny_records_writer_t *writer, const qrtiny_record_t *records, size_t count);
+bool QrTinyRecordsWriterClose(qrtiny_records_writer_t *writer);
+
+// Reading a (memory-mapped) record file
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+    uint64_t count;
+    size_t recordSize;
+    const uint8_t *index;   // NULL if none
+    void *mapping;          // Platform handle
+} qrtiny_records_t;
+
+bool QrTinyRecordsOpen(qrtiny_records_t *records, const char *filename);
+void QrTinyRecordsClose(qrtiny_records_t *records);
+// Zero-copy pointer to record number n (NULL if out of range); record->buffer can be passed directly to QrTinyModuleGet()/QrTinyRender()
+const qrtiny_record_t *QrTinyRecordsGet(const qrtiny_records_t *records, uint64_t n);
+// Find the record number with the given payload text using the index (matches are confirmed by decoding), or -1 if not found (or no index)
+int64_t QrTinyRecordsFind(const qrtiny_records_t *records, const char *text, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
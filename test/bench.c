@@ -0,0 +1,302 @@
+// QR Code V1-V4 Generator - Benchmark
+// Dan Jackson, 2020
+//
+// Output is comma-separated values, one line per phase, payload, error-correction level and mask pattern, for comparison between builds.
+
+#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS
+#include <windows.h>
+#else
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Included directly for access to the internal QrTinyRSRemainder()
+#include "../qrtiny.c"
+
+#define BENCH_MIN_TIME_NS 20000000.0    // Time each measurement for at least 20 ms
+
+static double BenchTime(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+typedef struct {
+    const char *name;
+    int mode;
+    const char *text;       // Fits at all error-correction levels
+} bench_payload_t;
+
+static const bench_payload_t benchPayloads[] = {
+    { "numeric", QRTINY_MODE_NUMERIC, "28147497671065" },
+    { "alphanumeric", QRTINY_MODE_ALPHANUMERIC, "HTTPS://X/" },
+    { "8bit", QRTINY_MODE_8BIT, "abc-123" },
+};
+static const char benchEclNames[4] = { 'M', 'L', 'H', 'Q' };
+
+// Benchmark state
+static const bench_payload_t *payload;
+static int ecl;
+static uint16_t formatInfo;
+static uint8_t buffer[QRTINY_BUFFER_SIZE];
+static size_t payloadLength;
+static volatile uint32_t sink;
+static uint32_t benchCodesPerOp = 1;    // For the codes per second of batch operations
+
+static size_t BenchWrite(void)
+{
+    size_t length = strlen(payload->text);
+    switch (payload->mode)
+    {
+        case QRTINY_MODE_NUMERIC: return QrTinyWriteNumericN(buffer, 0, payload->text, length);
+        case QRTINY_MODE_ALPHANUMERIC: return QrTinyWriteAlphanumericN(buffer, 0, payload->text, length);
+        default: return QrTinyWrite8BitN(buffer, 0, payload->text, length);
+    }
+}
+
+static void BenchOpWrite(uint32_t i) { (void)i; sink += (uint32_t)BenchWrite(); }
+static void BenchOpGenerate(uint32_t i) { buffer[0] ^= (uint8_t)i; sink += QrTinyGenerate(buffer, payloadLength, formatInfo); }
+static void BenchOpRSRemainder(uint32_t i)
+{
+    int eccCodewords = qrcode_ecc_block_codewords[ecl];
+    size_t dataCodewords = QrTinyDataCodewords(ecl);
+    size_t blockData = dataCodewords / (size_t)qrcode_ecc_blocks[ecl];
+    buffer[0] ^= (uint8_t)i;
+    for (int block = 0; block < qrcode_ecc_blocks[ecl]; block++)
+    {
+        QrTinyRSRemainder(buffer + (size_t)block * blockData, blockData, eccDivisors[ecl], eccCodewords, buffer + dataCodewords + (size_t)(block * eccCodewords));
+    }
+    sink += buffer[QRTINY_BUFFER_SIZE - 1];
+}
+static void BenchOpModuleGet(uint32_t i)
+{
+    (void)i;
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        for (int x = 0; x < QRTINY_DIMENSION; x++)
+        {
+            sink += (uint32_t)QrTinyModuleGet(buffer, formatInfo, x, y);
+        }
+    }
+}
+static void BenchOpRowGet(uint32_t i)
+{
+    (void)i;
+    for (int y = 0; y < QRTINY_DIMENSION; y++)
+    {
+        sink += (uint32_t)QrTinyRowGet(buffer, formatInfo, y, QRTINY_QUIET_NONE);
+    }
+}
+static void BenchOpRender(uint32_t i)
+{
+    qrtiny_row_t rows[QRTINY_DIMENSION];
+    QrTinyRender(buffer, formatInfo, rows);
+    sink += rows[i % QRTINY_DIMENSION];
+}
+// Batches of codes at the same error-correction level, generated together or one at a time
+#define BENCH_BATCH 256
+static uint8_t benchBatch[BENCH_BATCH][QRTINY_BUFFER_SIZE];
+static uint8_t *benchBatchPointers[BENCH_BATCH];
+static size_t benchBatchLengths[BENCH_BATCH];
+static void BenchBatchInit(void)
+{
+    for (int n = 0; n < BENCH_BATCH; n++)
+    {
+        benchBatchLengths[n] = BenchWrite();
+        memcpy(benchBatch[n], buffer, QRTINY_BUFFER_SIZE);
+        benchBatch[n][2] ^= (uint8_t)n;
+        benchBatchPointers[n] = benchBatch[n];
+    }
+}
+static void BenchOpGenerateSingles(uint32_t i)
+{
+    for (int n = 0; n < BENCH_BATCH; n++) QrTinyGenerate(benchBatch[n], benchBatchLengths[n], formatInfo);
+    sink += benchBatch[i % BENCH_BATCH][QRTINY_BUFFER_SIZE - 1];
+}
+static void BenchOpGenerateBatch(uint32_t i)
+{
+    QrTinyGenerateBatch(benchBatchPointers, benchBatchLengths, BENCH_BATCH, formatInfo);
+    sink += benchBatch[i % BENCH_BATCH][QRTINY_BUFFER_SIZE - 1];
+}
+#ifdef QRTINY_SIMD_X86
+static uint8_t benchNibbleTables[QRTINY_ECC_CODEWORDS_MAX][32];
+static void BenchOpRSBatchSSSE3(uint32_t i)
+{
+    int eccCodewords = qrcode_ecc_block_codewords[ecl];
+    size_t blockData = QrTinyDataCodewords(ecl) / (size_t)qrcode_ecc_blocks[ecl];
+    for (int n = 0; n < BENCH_BATCH; n += 16) QrTinyRSRemainderSSSE3(benchBatchPointers + n, 16, 0, blockData, QrTinyDataCodewords(ecl), benchNibbleTables, eccCodewords);
+    sink += benchBatch[i % BENCH_BATCH][QRTINY_BUFFER_SIZE - 1];
+}
+static void BenchOpRSBatchAVX2(uint32_t i)
+{
+    int eccCodewords = qrcode_ecc_block_codewords[ecl];
+    size_t blockData = QrTinyDataCodewords(ecl) / (size_t)qrcode_ecc_blocks[ecl];
+    for (int n = 0; n < BENCH_BATCH; n += 32) QrTinyRSRemainderAVX2(benchBatchPointers + n, 32, 0, blockData, QrTinyDataCodewords(ecl), benchNibbleTables, eccCodewords);
+    sink += benchBatch[i % BENCH_BATCH][QRTINY_BUFFER_SIZE - 1];
+}
+#endif
+
+#define BENCH_BLIT_SCALE 8
+#define BENCH_BLIT_SIZE ((QRTINY_DIMENSION + 2 * QRTINY_QUIET_STANDARD) * BENCH_BLIT_SCALE)
+static int benchPixelFormat;
+static void BenchOpBlit(uint32_t i)
+{
+    // Whole symbol, with the standard quiet margin, scaled into a surface
+    static uint8_t surface[BENCH_BLIT_SIZE * BENCH_BLIT_SIZE * 2];
+    size_t stride = (benchPixelFormat == QRTINY_PIXEL_RGB565) ? BENCH_BLIT_SIZE * 2 : (benchPixelFormat == QRTINY_PIXEL_8BPP) ? BENCH_BLIT_SIZE : (BENCH_BLIT_SIZE + 7) / 8;
+    QrTinyBlit(buffer, formatInfo, surface, stride, benchPixelFormat, BENCH_BLIT_SCALE, QRTINY_QUIET_STANDARD, false);
+    sink += surface[i % sizeof(surface)];
+}
+static void BenchOpVerify(uint32_t i)
+{
+    // Verify a rendered symbol, and decode it back to text
+    static qrtiny_row_t rows[QRTINY_DIMENSION];
+    uint8_t decoded[QRTINY_BUFFER_SIZE];
+    uint16_t decodedFormatInfo;
+    char text[64];
+    if (i == 0) QrTinyRender(buffer, formatInfo, rows);
+    sink += (uint32_t)QrTinyVerify(rows, decoded, &decodedFormatInfo);
+    sink += (uint32_t)QrTinyDecode(decoded, decodedFormatInfo, text, sizeof(text));
+}
+static void BenchOpChooseMask(uint32_t i) { (void)i; sink += QrTinyChooseMask(buffer, ecl); }
+static void BenchOpCode(uint32_t i)
+{
+    // Complete code: write, generate, choose mask, render
+    qrtiny_row_t rows[QRTINY_DIMENSION];
+    size_t length = BenchWrite();
+    buffer[2] ^= (uint8_t)i;
+    QrTinyGenerate(buffer, length, QrTinyFormatInfo(ecl, 0));
+    QrTinyRender(buffer, QrTinyChooseMask(buffer, ecl), rows);
+    sink += rows[i % QRTINY_DIMENSION];
+}
+static qrtiny_template_t benchTemplate;
+static size_t benchSerialOffset;
+static void BenchOpSerialGenerate(uint32_t i)
+{
+    // Serial-numbered code generated in full
+    char serial[7];
+    snprintf(serial, sizeof(serial), "%06lu", (unsigned long)(i % 1000000));
+    size_t length = benchSerialOffset + QrTinyWriteNumeric(buffer, benchSerialOffset, serial);
+    QrTinyGenerate(buffer, length, formatInfo);
+    qrtiny_row_t rows[QRTINY_DIMENSION];
+    QrTinyRender(buffer, formatInfo, rows);
+    sink += rows[i % QRTINY_DIMENSION];
+}
+static void BenchOpSerialTemplate(uint32_t i)
+{
+    // Serial-numbered code updated from a template
+    char serial[7];
+    snprintf(serial, sizeof(serial), "%06lu", (unsigned long)(i % 1000000));
+    size_t bitCount = QrTinyWriteNumeric(benchTemplate.buffer, benchSerialOffset, serial);
+    QrTinyTemplateUpdate(&benchTemplate, benchSerialOffset, bitCount);
+    sink += benchTemplate.rows[i % QRTINY_DIMENSION];
+}
+static uint8_t benchDiffBuffer[QRTINY_BUFFER_SIZE];
+static void BenchOpDiff(uint32_t i)
+{
+    // Changed regions between consecutive serial-numbered codes
+    qrtiny_rect_t rects[4];
+    sink += (uint32_t)QrTinyDiff(buffer, formatInfo, benchDiffBuffer, formatInfo, rects, 4) + rects[0].x + i;
+}
+
+// Run an operation for at least the minimum time and report the time per operation
+static void BenchRun(const char *phase, void (*op)(uint32_t), const char *payloadName, int eclIndex, int maskPattern)
+{
+    uint32_t iterations = 1;
+    double elapsed;
+    for (;;)
+    {
+        double start = BenchTime();
+        for (uint32_t i = 0; i < iterations; i++) op(i);
+        elapsed = BenchTime() - start;
+        if (elapsed >= BENCH_MIN_TIME_NS || iterations >= 0x40000000) break;
+        iterations *= (elapsed > BENCH_MIN_TIME_NS / 64) ? 2 : 16;
+    }
+    double ns = elapsed / iterations / benchCodesPerOp;
+    printf("%s,%s,%c,%c,%lu,%.1f,%.0f\n", phase, payloadName ? payloadName : "-", eclIndex >= 0 ? benchEclNames[eclIndex] : '-', maskPattern >= 0 ? '0' + maskPattern : '-', (unsigned long)iterations, ns, 1e9 / ns);
+}
+
+int main(void)
+{
+    printf("phase,payload,ecl,mask,iterations,ns_per_op,codes_per_sec\n");
+    for (size_t p = 0; p < sizeof(benchPayloads) / sizeof(benchPayloads[0]); p++)
+    {
+        payload = &benchPayloads[p];
+        BenchRun("write", BenchOpWrite, payload->name, -1, -1);
+        for (ecl = 0; ecl < 4; ecl++)
+        {
+            formatInfo = QrTinyFormatInfo(ecl, 0);
+            payloadLength = BenchWrite();
+            BenchRun("generate", BenchOpGenerate, payload->name, ecl, -1);
+            BenchRun("code", BenchOpCode, payload->name, ecl, -1);
+        }
+    }
+
+    payload = &benchPayloads[1];
+    for (ecl = 0; ecl < 4; ecl++)
+    {
+        BenchRun("rs_remainder", BenchOpRSRemainder, NULL, ecl, -1);
+        payloadLength = BenchWrite();
+        QrTinyGenerate(buffer, payloadLength, QrTinyFormatInfo(ecl, 0));
+        BenchRun("choose_mask", BenchOpChooseMask, payload->name, ecl, -1);
+        formatInfo = QrTinyFormatInfo(ecl, 0);
+        BenchRun("verify_decode", BenchOpVerify, payload->name, ecl, 0);
+        for (int maskPattern = 0; maskPattern < 8; maskPattern++)
+        {
+            formatInfo = QrTinyFormatInfo(ecl, maskPattern);
+            BenchRun("module_get", BenchOpModuleGet, payload->name, ecl, maskPattern);
+            BenchRun("row_get", BenchOpRowGet, payload->name, ecl, maskPattern);
+            BenchRun("render", BenchOpRender, payload->name, ecl, maskPattern);
+        }
+    }
+
+    // Batches of codes (times are per code)
+    benchCodesPerOp = BENCH_BATCH;
+    for (ecl = 0; ecl < 4; ecl++)
+    {
+        formatInfo = QrTinyFormatInfo(ecl, 0);
+        BenchBatchInit();
+        BenchRun("generate_singles", BenchOpGenerateSingles, payload->name, ecl, -1);
+        BenchRun("generate_batch", BenchOpGenerateBatch, payload->name, ecl, -1);
+#ifdef QRTINY_SIMD_X86
+        QrTinyNibbleTables(eccDivisors[ecl], qrcode_ecc_block_codewords[ecl], benchNibbleTables);
+        if (__builtin_cpu_supports("ssse3")) BenchRun("rs_batch_ssse3", BenchOpRSBatchSSSE3, NULL, ecl, -1);
+        if (__builtin_cpu_supports("avx2")) BenchRun("rs_batch_avx2", BenchOpRSBatchAVX2, NULL, ecl, -1);
+#endif
+    }
+    benchCodesPerOp = 1;
+
+    // Scaled blits (x8) of one symbol, in each pixel format
+    static const char *const pixelFormatNames[] = { "blit_1bpp_msb", "blit_1bpp_lsb", "blit_8bpp", "blit_rgb565" };
+    formatInfo = QrTinyFormatInfo(QRTINY_ECL_QUARTILE, 0);
+    for (benchPixelFormat = QRTINY_PIXEL_1BPP_MSB; benchPixelFormat <= QRTINY_PIXEL_RGB565; benchPixelFormat++)
+    {
+        BenchRun(pixelFormatNames[benchPixelFormat], BenchOpBlit, payload->name, QRTINY_ECL_QUARTILE, 0);
+    }
+
+    // Codes differing only in a trailing serial number (at the lowest error-correction level, for the longest prefix)
+    ecl = QRTINY_ECL_LOW;
+    formatInfo = QrTinyFormatInfo(ecl, 0);
+    benchSerialOffset = QrTinyWriteAlphanumeric(buffer, 0, "HTTPS://XYZ.DEV/-");
+    BenchRun("serial_generate", BenchOpSerialGenerate, "serial", ecl, 0);
+    QrTinyGenerate(buffer, benchSerialOffset + QrTinyWriteNumeric(buffer, benchSerialOffset, "000000"), formatInfo);
+    QrTinyTemplateInit(&benchTemplate, buffer, formatInfo);
+    BenchRun("serial_template", BenchOpSerialTemplate, "serial", ecl, 0);
+    memcpy(benchDiffBuffer, buffer, sizeof(buffer));
+    QrTinyGenerate(benchDiffBuffer, benchSerialOffset + QrTinyWriteNumeric(benchDiffBuffer, benchSerialOffset, "000001"), formatInfo);
+    BenchRun("serial_diff", BenchOpDiff, "serial", ecl, 0);
+    return 0;
+}
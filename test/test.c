@@ -0,0 +1,601 @@
+// QR Code V1-V4 Generator - Tests
+// Dan Jackson, 2020
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "qrtiny.h"
+#include "qrtinyrecords.h"
+
+static int failures = 0;
+#define TEST_CHECK(_condition) do { if (!(_condition)) { fprintf(stderr, "FAIL: %s:%d: %s\n", __FILE__, __LINE__, #_condition); failures++; } } while (0)
+
+// Golden matrices (bit x of row y is the module at (x, y)) for the fixed payload below, for each error-correction level (QRTINY_ECL_*) and mask pattern
+#define TEST_GOLDEN_NUMERIC "0123"
+#define TEST_GOLDEN_ALPHANUMERIC "AB"
+#define TEST_GOLDEN_8BIT "c"
+// (for V2-V4, one matrix for each error-correction level, at the mask pattern given; V3/V4 include levels split into blocks)
+#if QRTINY_VERSION == 1
+static const uint32_t testGolden[4 * 8][QRTINY_DIMENSION] = {
+    { 0x1fce7f, 0x105541, 0x17525d, 0x175e5d, 0x17595d, 0x104c41, 0x1fd57f, 0x000000, 0x091455, 0x0b2db8, 0x0b4fde, 0x0bbbb6, 0x11cac6, 0x0a4700, 0x15147f, 0x02c041, 0x17575d, 0x0aa85d, 0x17ef5d, 0x043a41, 0x14eb7f },
+    { 0x1fc57f, 0x105e41, 0x17595d, 0x17545d, 0x17525d, 0x104741, 0x1fd57f, 0x000a00, 0x149ec5, 0x018712, 0x01e574, 0x01111c, 0x1b606c, 0x00ed00, 0x1fbf7f, 0x086a41, 0x1dfc5d, 0x00025d, 0x1d455d, 0x0e9041, 0x1e417f },
+    { 0x1fc87f, 0x104c41, 0x17555d, 0x17475d, 0x175f5d, 0x105541, 0x1fd57f, 0x001900, 0x07d27d, 0x05151b, 0x1a88c2, 0x058315, 0x000dda, 0x047f00, 0x04d27f, 0x0cf941, 0x06915d, 0x04915d, 0x06295d, 0x0a0241, 0x052d7f },
+    { 0x1fc97f, 0x105741, 0x17425d, 0x17475d, 0x17445d, 0x104241, 0x1fd57f, 0x000300, 0x1a44ed, 0x05151b, 0x0c53ef, 0x08358e, 0x000dda, 0x12a500, 0x09657f, 0x0cf941, 0x104a5d, 0x09275d, 0x06295d, 0x1cd841, 0x089b7f },
+    { 0x1fcb7f, 0x104e41, 0x17485d, 0x175b5d, 0x175d5d, 0x105741, 0x1fd57f, 0x000500, 0x13f1d1, 0x1df695, 0x1d94f3, 0x029f24, 0x18ee54, 0x1c9d00, 0x03cf7f, 0x0be441, 0x1e735d, 0x1c725d, 0x01345d, 0x0d1e41, 0x1dcf7f },
+    { 0x1fc47f, 0x104f41, 0x17555d, 0x17415d, 0x175e5d, 0x105641, 0x1fd57f, 0x001b00, 0x0e7341, 0x14d207, 0x1a88c2, 0x05011d, 0x1b606c, 0x04fd00, 0x04d27f, 0x1d3e41, 0x06905d, 0x04125d, 0x1d445d, 0x0a8041, 0x052d7f },
+    { 0x1fc57f, 0x104f41, 0x17515d, 0x17405d, 0x17575d, 0x105a41, 0x1fd57f, 0x001a00, 0x1d37f9, 0x14d207, 0x08c1e6, 0x060d2d, 0x1b606c, 0x1c9d00, 0x0df77f, 0x1d3f41, 0x14d95d, 0x071f5d, 0x1d445d, 0x12e041, 0x0c097f },
+    { 0x1fce7f, 0x105041, 0x175a5d, 0x175e5d, 0x175c5d, 0x104541, 0x1fd57f, 0x000400, 0x00bd69, 0x0b2db8, 0x026b4c, 0x19f292, 0x11cac6, 0x036300, 0x075c7f, 0x02c141, 0x1e725d, 0x18e15d, 0x17ee5d, 0x0d1e41, 0x06a37f },
+    { 0x1fd47f, 0x105041, 0x17455d, 0x17505d, 0x175a5d, 0x104e41, 0x1fd57f, 0x000500, 0x0475f7, 0x0b2d91, 0x0b4fc3, 0x0bbfb4, 0x11ca6c, 0x0a4300, 0x15177f, 0x02c541, 0x17555d, 0x0aae5d, 0x17ef5d, 0x043b41, 0x14ed7f },
+    { 0x1fdf7f, 0x105b41, 0x174e5d, 0x175a5d, 0x17515d, 0x104541, 0x1fd57f, 0x000f00, 0x19ff67, 0x01873b, 0x01e569, 0x01151e, 0x1b60c6, 0x00e900, 0x1fbc7f, 0x086f41, 0x1dfe5d, 0x00045d, 0x1d455d, 0x0e9141, 0x1e477f },
+    { 0x1fd27f, 0x104941, 0x17425d, 0x17495d, 0x175c5d, 0x105741, 0x1fd57f, 0x001c00, 0x0ab3df, 0x051532, 0x1a88df, 0x058717, 0x000d70, 0x047b00, 0x04d17f, 0x0cfc41, 0x06935d, 0x04975d, 0x06295d, 0x0a0341, 0x052b7f },
+    { 0x1fd37f, 0x105241, 0x17555d, 0x17495d, 0x17475d, 0x104041, 0x1fd57f, 0x000600, 0x17254f, 0x051532, 0x0c53f2, 0x08318c, 0x000d70, 0x12a100, 0x09667f, 0x0cfc41, 0x10485d, 0x09215d, 0x06295d, 0x1cd941, 0x089d7f },
+    { 0x1fd17f, 0x104b41, 0x175f5d, 0x17555d, 0x175e5d, 0x105541, 0x1fd57f, 0x000000, 0x1e9073, 0x1df6bc, 0x1d94ee, 0x029b26, 0x18eefe, 0x1c9900, 0x03cc7f, 0x0be141, 0x1e715d, 0x1c745d, 0x01345d, 0x0d1f41, 0x1dc97f },
+    { 0x1fde7f, 0x104a41, 0x17425d, 0x174f5d, 0x175d5d, 0x105441, 0x1fd57f, 0x001e00, 0x0312e3, 0x14d22e, 0x1a88df, 0x05051f, 0x1b60c6, 0x04f900, 0x04d17f, 0x1d3b41, 0x06925d, 0x04145d, 0x1d445d, 0x0a8141, 0x052b7f },
+    { 0x1fdf7f, 0x104a41, 0x17465d, 0x174e5d, 0x17545d, 0x105841, 0x1fd57f, 0x001f00, 0x10565b, 0x14d22e, 0x08c1fb, 0x06092f, 0x1b60c6, 0x1c9900, 0x0df47f, 0x1d3a41, 0x14db5d, 0x07195d, 0x1d445d, 0x12e141, 0x0c0f7f },
+    { 0x1fd47f, 0x105541, 0x174d5d, 0x17505d, 0x175f5d, 0x104741, 0x1fd57f, 0x000100, 0x0ddccb, 0x0b2d91, 0x026b51, 0x19f690, 0x11ca6c, 0x036700, 0x075f7f, 0x02c441, 0x1e705d, 0x18e75d, 0x17ee5d, 0x0d1f41, 0x06a57f },
+    { 0x1fc57f, 0x104241, 0x17585d, 0x17455d, 0x175c5d, 0x104e41, 0x1fd57f, 0x000400, 0x122774, 0x0b1bae, 0x0b26c4, 0x0b9a2e, 0x11bdd4, 0x0a4d00, 0x15327f, 0x029741, 0x174d5d, 0x0ab85d, 0x17c35d, 0x041041, 0x14e47f },
+    { 0x1fce7f, 0x104941, 0x17535d, 0x174f5d, 0x17575d, 0x104541, 0x1fd57f, 0x000e00, 0x0fade4, 0x01b104, 0x018c6e, 0x013084, 0x1b177e, 0x00e700, 0x1f997f, 0x083d41, 0x1de65d, 0x00125d, 0x1d695d, 0x0eba41, 0x1e4e7f },
+    { 0x1fc37f, 0x105b41, 0x175f5d, 0x175c5d, 0x175a5d, 0x105741, 0x1fd57f, 0x001d00, 0x1ce15c, 0x05230d, 0x1ae1d8, 0x05a28d, 0x007ac8, 0x047500, 0x04f47f, 0x0cae41, 0x068b5d, 0x04815d, 0x06055d, 0x0a2841, 0x05227f },
+    { 0x1fc27f, 0x104041, 0x17485d, 0x175c5d, 0x17415d, 0x104041, 0x1fd57f, 0x000700, 0x0177cc, 0x05230d, 0x0c3af5, 0x081416, 0x007ac8, 0x12af00, 0x09437f, 0x0cae41, 0x10505d, 0x09375d, 0x06055d, 0x1cf241, 0x08947f },
+    { 0x1fc07f, 0x105941, 0x17425d, 0x17405d, 0x17585d, 0x105541, 0x1fd57f, 0x000100, 0x08c2f0, 0x1dc083, 0x1dfde9, 0x02bebc, 0x189946, 0x1c9700, 0x03e97f, 0x0bb341, 0x1e695d, 0x1c625d, 0x01185d, 0x0d3441, 0x1dc07f },
+    { 0x1fcf7f, 0x105841, 0x175f5d, 0x175a5d, 0x175b5d, 0x105441, 0x1fd57f, 0x001f00, 0x154060, 0x14e411, 0x1ae1d8, 0x052085, 0x1b177e, 0x04f700, 0x04f47f, 0x1d6941, 0x068a5d, 0x04025d, 0x1d685d, 0x0aaa41, 0x05227f },
+    { 0x1fce7f, 0x105841, 0x175b5d, 0x175b5d, 0x17525d, 0x105841, 0x1fd57f, 0x001e00, 0x0604d8, 0x14e411, 0x08a8fc, 0x062cb5, 0x1b177e, 0x1c9700, 0x0dd17f, 0x1d6841, 0x14c35d, 0x070f5d, 0x1d685d, 0x12ca41, 0x0c067f },
+    { 0x1fc57f, 0x104741, 0x17505d, 0x17455d, 0x17595d, 0x104741, 0x1fd57f, 0x000000, 0x1b8e48, 0x0b1bae, 0x020256, 0x19d30a, 0x11bdd4, 0x036900, 0x077a7f, 0x029641, 0x1e685d, 0x18f15d, 0x17c25d, 0x0d3441, 0x06ac7f },
+    { 0x1fdf7f, 0x105341, 0x175b5d, 0x17555d, 0x17595d, 0x105441, 0x1fd57f, 0x001b00, 0x1f42d6, 0x0b3f94, 0x0b4e6e, 0x0bb897, 0x11dc79, 0x0a5f00, 0x15097f, 0x02cc41, 0x17435d, 0x0aac5d, 0x17e95d, 0x043f41, 0x14ec7f },
+    { 0x1fd47f, 0x105841, 0x17505d, 0x175f5d, 0x17525d, 0x105f41, 0x1fd57f, 0x001100, 0x02c846, 0x01953e, 0x01e4c4, 0x01123d, 0x1b76d3, 0x00f500, 0x1fa27f, 0x086641, 0x1de85d, 0x00065d, 0x1d435d, 0x0e9541, 0x1e467f },
+    { 0x1fd97f, 0x104a41, 0x175c5d, 0x174c5d, 0x175f5d, 0x104d41, 0x1fd57f, 0x000200, 0x1184fe, 0x050737, 0x1a8972, 0x058034, 0x001b65, 0x046700, 0x04cf7f, 0x0cf541, 0x06855d, 0x04955d, 0x062f5d, 0x0a0741, 0x052a7f },
+    { 0x1fd87f, 0x105141, 0x174b5d, 0x174c5d, 0x17445d, 0x105a41, 0x1fd57f, 0x001800, 0x0c126e, 0x050737, 0x0c525f, 0x0836af, 0x001b65, 0x12bd00, 0x09787f, 0x0cf541, 0x105e5d, 0x09235d, 0x062f5d, 0x1cdd41, 0x089c7f },
+    { 0x1fda7f, 0x104841, 0x17415d, 0x17505d, 0x175d5d, 0x104f41, 0x1fd57f, 0x001e00, 0x05a752, 0x1de4b9, 0x1d9543, 0x029c05, 0x18f8eb, 0x1c8500, 0x03d27f, 0x0be841, 0x1e675d, 0x1c765d, 0x01325d, 0x0d1b41, 0x1dc87f },
+    { 0x1fd57f, 0x104941, 0x175c5d, 0x174a5d, 0x175e5d, 0x104e41, 0x1fd57f, 0x000000, 0x1825c2, 0x14c02b, 0x1a8972, 0x05023c, 0x1b76d3, 0x04e500, 0x04cf7f, 0x1d3241, 0x06845d, 0x04165d, 0x1d425d, 0x0a8541, 0x052a7f },
+    { 0x1fd47f, 0x104941, 0x17585d, 0x174b5d, 0x17575d, 0x104241, 0x1fd57f, 0x000100, 0x0b617a, 0x14c02b, 0x08c056, 0x060e0c, 0x1b76d3, 0x1c8500, 0x0dea7f, 0x1d3341, 0x14cd5d, 0x071b5d, 0x1d425d, 0x12e541, 0x0c0e7f },
+    { 0x1fdf7f, 0x105641, 0x17535d, 0x17555d, 0x175c5d, 0x105d41, 0x1fd57f, 0x001f00, 0x16ebea, 0x0b3f94, 0x026afc, 0x19f1b3, 0x11dc79, 0x037b00, 0x07417f, 0x02cd41, 0x1e665d, 0x18e55d, 0x17e85d, 0x0d1b41, 0x06a47f },
+};
+#elif QRTINY_VERSION == 2
+static const int testGoldenMasks[4] = { 1, 4, 6, 3 };
+static const qrtiny_row_t testGolden[4][QRTINY_DIMENSION] = {
+    { 0x1fcfb7f, 0x1048041, 0x174335d, 0x175825d, 0x1758e5d, 0x1056541, 0x1fd557f, 0x0002800, 0x149bac5, 0x1191d17, 0x1ef6ac4, 0x19bca94, 0x1de6f65, 0x0026496, 0x0588ad3, 0x064219c, 0x1ffbfdb, 0x0711500, 0x1d5f57f, 0x0b1dc41, 0x1ff665d, 0x01f665d, 0x1fe095d, 0x090a641, 0x1d5bf7f },
+    { 0x1fd617f, 0x104f941, 0x174535d, 0x174175d, 0x174165d, 0x1050741, 0x1fd557f, 0x001ac00, 0x1e83473, 0x005613f, 0x0f30767, 0x1785339, 0x13de8f3, 0x11e1781, 0x144fb68, 0x087ac18, 0x11f32d3, 0x1716500, 0x0d5867f, 0x0515141, 0x11fed5d, 0x103125d, 0x0e2785d, 0x0732f41, 0x136337f },
+    { 0x1fcb47f, 0x105c641, 0x174055d, 0x175b15d, 0x174945d, 0x1059641, 0x1fd557f, 0x0000c00, 0x06056d8, 0x04dbbb2, 0x1a620e2, 0x05d3d9b, 0x1de16ef, 0x11e3e85, 0x0caf37f, 0x1313d01, 0x1bf9fd9, 0x1b16b00, 0x1d5b37f, 0x1b19041, 0x17f315d, 0x14a715d, 0x1b7045d, 0x157b041, 0x1d5c27f },
+    { 0x1fd907f, 0x104df41, 0x174f35d, 0x1751e5d, 0x1743c5d, 0x1044841, 0x1fd557f, 0x0006a00, 0x0c17a6e, 0x03d853b, 0x082ddc8, 0x1d2f09f, 0x1051d5a, 0x0900eae, 0x1ee6b72, 0x140ddb5, 0x09f4c54, 0x0316d00, 0x115dc7f, 0x0319541, 0x05fdc5d, 0x13bf55d, 0x093ef5d, 0x0d9c141, 0x10ebc7f },
+};
+#elif QRTINY_VERSION == 3
+static const int testGoldenMasks[4] = { 2, 7, 0, 5 };
+static const qrtiny_row_t testGolden[4][QRTINY_DIMENSION] = {
+    { 0x1fc2f27f, 0x1053fc41, 0x1746a35d, 0x1740c35d, 0x17558d5d, 0x104c0f41, 0x1fd5557f, 0x00195b00, 0x07dd007d, 0x0102fc3b, 0x0bd3f253, 0x0f66ba0e, 0x0940c14d, 0x1eb598a2, 0x0a2c0046, 0x12995987, 0x09bd1f5f, 0x0902ff23, 0x11d3f8d9, 0x0966a899, 0x0bf0dfed, 0x0b159900, 0x0d541a7f, 0x01195141, 0x0ffd115d, 0x0952ff5d, 0x08bbb75d, 0x002e9241, 0x0880997f },
+    { 0x1fd3327f, 0x1054f941, 0x17453f5d, 0x174eee5d, 0x174d615d, 0x10506b41, 0x1fd5557f, 0x001e5300, 0x0dde84cb, 0x028ccc85, 0x05eb0775, 0x087ac08b, 0x153110da, 0x0f729c07, 0x12cf90fb, 0x1117739c, 0x0785ea73, 0x0e1e87bc, 0x0da226d5, 0x18a1aca4, 0x13f35fd1, 0x091bbb00, 0x035cfd7f, 0x07153841, 0x13fcce5d, 0x1895ef5d, 0x10586a5d, 0x03a08d41, 0x06b8377f },
+    { 0x1fc7197f, 0x10445641, 0x174e685d, 0x1756515d, 0x1755e05d, 0x105bb441, 0x1fd5557f, 0x000fb600, 0x12245d74, 0x0a8ede06, 0x0fc2646f, 0x0aafb438, 0x17549b71, 0x0a188ab6, 0x0bbf35d5, 0x1b75c21a, 0x093d9ffb, 0x0d3a2516, 0x107acb45, 0x05755192, 0x15f8af5d, 0x0319cb00, 0x1550047f, 0x0319d541, 0x17f5fd5d, 0x0aaed25d, 0x16b6ef5d, 0x0225fe41, 0x1773847f },
+    { 0x1fcce97f, 0x104b7141, 0x175f5e5d, 0x17491c5d, 0x1745ea5d, 0x10551441, 0x1fd5557f, 0x0000ca00, 0x1835afc2, 0x1570cf2e, 0x13b5d449, 0x01000085, 0x1dfeb6f7, 0x01b27f29, 0x17cbdc72, 0x048f3c16, 0x1549a9fd, 0x06960a99, 0x1ad096ef, 0x0ede670d, 0x09f8ebf9, 0x1d140100, 0x0954217f, 0x0911ba41, 0x1dff5a5d, 0x01017c5d, 0x0ac4205d, 0x1dd8b141, 0x0b050a7f },
+};
+#else
+static const int testGoldenMasks[4] = { 5, 3, 1, 7 };
+static const qrtiny_row_t testGolden[4][QRTINY_DIMENSION] = {
+    { 0x1fccccc7f, 0x105eaf941, 0x1749f2b5d, 0x17488815d, 0x17524885d, 0x104150841, 0x1fd55557f, 0x001405f00, 0x0e6358f41, 0x153111837, 0x1be359b61, 0x14d404eb1, 0x031ffef53, 0x040737e92, 0x1e1ca51ee, 0x154eeaa03, 0x061e834d9, 0x0c0376c3f, 0x1ff1153cf, 0x0c2bfac08, 0x068f91271, 0x12f555499, 0x01e35dcd5, 0x0bd407e0d, 0x1ffeee1cb, 0x051c06900, 0x1f5358a7f, 0x031112e41, 0x1df24e25d, 0x047f34a5d, 0x1d7912e5d, 0x0cf3fbc41, 0x074e8157f },
+    { 0x1fc35837f, 0x1041ac041, 0x17594f95d, 0x174bd0b5d, 0x174f42f5d, 0x1053e5241, 0x1fd55557f, 0x000b06a00, 0x1720d614f, 0x03035831f, 0x0941ac069, 0x02994f9b4, 0x040bd0be2, 0x1a6f42c33, 0x09d3e5572, 0x04d06b339, 0x102d6084d, 0x1ab583338, 0x019ac1cf4, 0x0bf4f95b8, 0x0fbd0be6f, 0x04b42f6a9, 0x0abe53e54, 0x0966b0422, 0x05f60d259, 0x151835b00, 0x0d541ac7f, 0x0b1f94a41, 0x13f0bd25d, 0x0952f455d, 0x070d3e55d, 0x1b4306941, 0x0a80d677f },
+    { 0x1fd84d07f, 0x1046c4541, 0x175c5b35d, 0x17542ff5d, 0x175ed295d, 0x105105741, 0x1fd55557f, 0x000408a00, 0x0fbfdf3e4, 0x00367b63c, 0x05f1be5d5, 0x103bc5394, 0x05e3d3570, 0x07a0b8992, 0x1a8927d64, 0x0fc003c1b, 0x1f1ca4bf0, 0x0815662bd, 0x1f6fc6ae0, 0x0e35e8698, 0x1ff753041, 0x01b78cd92, 0x04f1e04c7, 0x11bb4358c, 0x05f330373, 0x07196a900, 0x1b5ec7b7f, 0x0715e9541, 0x1ffee8c5d, 0x016fc4a5d, 0x1dff6f35d, 0x09e759c41, 0x1da367e7f },
+    { 0x1fc67f17f, 0x1040cb041, 0x1747de35d, 0x17576015d, 0x1751dd25d, 0x10529b341, 0x1fd55557f, 0x000a6e100, 0x16ed755ea, 0x0acee168e, 0x0300c5978, 0x0827dec39, 0x09b5494e4, 0x03996ff86, 0x1d92cd977, 0x0ab142c2b, 0x1efd54265, 0x10f0da002, 0x155bf0c7f, 0x0bb5a4f11, 0x0501d745f, 0x0d0a9681a, 0x1900fbb4b, 0x1727eaa9a, 0x15f4128dd, 0x031235f00, 0x1d5d1317f, 0x1d1e9df41, 0x05f1b365d, 0x188cc615d, 0x17d3b065d, 0x0b6dda341, 0x04c0e447f },
+};
+#endif
+
+static size_t TestGoldenPayload(uint8_t *buffer)
+{
+    size_t payloadLength = 0;
+    payloadLength += QrTinyWriteNumeric(buffer, payloadLength, TEST_GOLDEN_NUMERIC);
+    payloadLength += QrTinyWriteAlphanumeric(buffer, payloadLength, TEST_GOLDEN_ALPHANUMERIC);
+    payloadLength += QrTinyWrite8Bit(buffer, payloadLength, TEST_GOLDEN_8BIT);
+    return payloadLength;
+}
+
+// Full matrix, both the per-module and the whole-symbol rendering, for all 32 format values (against the golden matrices where given)
+static void TestGolden(void)
+{
+    for (int ecl = 0; ecl < 4; ecl++)
+    {
+        for (int maskPattern = 0; maskPattern < 8; maskPattern++)
+        {
+            uint16_t formatInfo = QrTinyFormatInfo(ecl, maskPattern);
+            uint8_t buffer[QRTINY_BUFFER_SIZE];
+            size_t payloadLength = TestGoldenPayload(buffer);
+            TEST_CHECK(QrTinyGenerate(buffer, payloadLength, formatInfo));
+
+            qrtiny_row_t rows[QRTINY_DIMENSION];
+            QrTinyRender(buffer, formatInfo, rows);
+#if QRTINY_VERSION == 1
+            TEST_CHECK(memcmp(rows, testGolden[ecl * 8 + maskPattern], sizeof(rows)) == 0);
+#else
+            if (maskPattern == testGoldenMasks[ecl]) TEST_CHECK(memcmp(rows, testGolden[ecl], sizeof(rows)) == 0);
+#endif
+
+            int mismatches = 0;
+            for (int y = 0; y < QRTINY_DIMENSION; y++)
+            {
+                for (int x = 0; x < QRTINY_DIMENSION; x++)
+                {
+                    if (QrTinyModuleGet(buffer, formatInfo, x, y) != (int)((rows[y] >> x) & 1)) mismatches++;
+                }
+            }
+            TEST_CHECK(mismatches == 0);
+        }
+    }
+}
+
+// Whole rows match the modules, including the quiet margin, for all 32 format values
+static void TestRowGet(void)
+{
+    for (int format = 0; format < 32; format++)
+    {
+        uint16_t formatInfo = QrTinyFormatInfo(format >> 3, format & 7);
+        uint8_t buffer[QRTINY_BUFFER_SIZE];
+        TEST_CHECK(QrTinyGenerate(buffer, TestGoldenPayload(buffer), formatInfo));
+        for (int quiet = QRTINY_QUIET_NONE; quiet <= QRTINY_QUIET_STANDARD; quiet++)
+        {
+            int mismatches = 0;
+            for (int y = -quiet; y < QRTINY_DIMENSION + quiet; y++)
+            {
+                qrtiny_quiet_row_t expected = 0;
+                for (int x = -quiet; x < QRTINY_DIMENSION + quiet; x++)
+                {
+                    expected |= (qrtiny_quiet_row_t)QrTinyModuleGet(buffer, formatInfo, x, y) << (x + quiet);
+                }
+                if (QrTinyRowGet(buffer, formatInfo, y, quiet) != expected) mismatches++;
+            }
+            TEST_CHECK(mismatches == 0);
+        }
+        TEST_CHECK(QrTinyRowGet(buffer, formatInfo, 0, QRTINY_QUIET_STANDARD + 1) == 0);
+    }
+}
+
+// The length-delimited writers match the null-terminated ones, at any bit offset and without disturbing neighbouring bits
+static void TestWriters(void)
+{
+    static const char *texts[] = { "", "7", "42", "0123456789", "HELLO WORLD", "HTTPS://XYZ.DEV/-000123", "abc!~" };
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++)
+    {
+        for (size_t offset = 0; offset < 8; offset++)
+        {
+            uint8_t a[QRTINY_BUFFER_SIZE * 2], b[QRTINY_BUFFER_SIZE * 2];
+            memset(a, 0xa5, sizeof(a));
+            memset(b, 0xa5, sizeof(b));
+            size_t length = strlen(texts[t]);
+            TEST_CHECK(QrTinyWrite8Bit(a, offset, texts[t]) == QrTinyWrite8BitN(b, offset, texts[t], length));
+            TEST_CHECK(QrTinyWriteAlphanumeric(a, offset + 3, texts[t]) == QrTinyWriteAlphanumericN(b, offset + 3, texts[t], length));
+            TEST_CHECK(memcmp(a, b, sizeof(a)) == 0);
+        }
+    }
+
+    // 8-bit data may include null bytes
+    uint8_t buffer[QRTINY_BUFFER_SIZE] = { 0 };
+    TEST_CHECK(QrTinyWrite8BitN(buffer, 0, "A\0B", 3) == 4 + 8 + 3 * 8);
+    TEST_CHECK(buffer[0] == 0x40 && buffer[1] == 0x34 && buffer[2] == 0x10 && buffer[3] == 0x04 && buffer[4] == 0x20);
+}
+
+// The planner's choices
+static void TestPlan(void)
+{
+    qrtiny_plan_t plan;
+    TEST_CHECK(QrTinyPlan("HELLO", 5, &plan) && plan.segmentCount == 1 && plan.segments[0].mode == QRTINY_MODE_ALPHANUMERIC && plan.ecl == QRTINY_ECL_HIGH);
+    TEST_CHECK(QrTinyPlan("hello", 5, &plan) && plan.segmentCount == 1 && plan.segments[0].mode == QRTINY_MODE_8BIT);
+#if QRTINY_VERSION == 1
+    TEST_CHECK(QrTinyPlan("12345678901234567890123456789012345678901", 41, &plan) && plan.segments[0].mode == QRTINY_MODE_NUMERIC && plan.ecl == QRTINY_ECL_LOW);
+    TEST_CHECK(!QrTinyPlan("123456789012345678901234567890123456789012", 42, &plan));
+#else
+    TEST_CHECK(QrTinyPlan("123456789012345678901234567890123456789012", 42, &plan) && plan.segments[0].mode == QRTINY_MODE_NUMERIC && plan.ecl != QRTINY_ECL_LOW);
+    // More segments than fit in V1 (9, in 252 bits)
+    TEST_CHECK(QrTinyPlan("a1111111a1111111a1111111a1111111a", 33, &plan) && plan.segmentCount == 9 && plan.bits == 252);
+#endif
+    TEST_CHECK(QrTinyPlan("ABCDE012345678901", 17, &plan) && plan.segmentCount == 2 && plan.bits == (4 + 9 + 2 * 11 + 6) + (4 + 10 + 4 * 10));
+
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+    // Within the segment limit, no longer than all 8-bit (a smaller QRTINY_PLAN_SEGMENTS_MAX encodes the start as 8-bit)
+    static const char *texts[] = { "0123ABc", "1a2b3c4d5e6f7", "a1111111a1111111a" };
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++)
+    {
+        size_t length = strlen(texts[t]);
+        TEST_CHECK(QrTinyPlan(texts[t], length, &plan) && plan.segmentCount <= QRTINY_PLAN_SEGMENTS_MAX && plan.bits <= 4 + 8 + 8 * length);
+        TEST_CHECK(QrTinyPlanWrite(buffer, 0, texts[t], &plan) == plan.bits);
+    }
+    TEST_CHECK(QrTinyPlan(TEST_GOLDEN_NUMERIC TEST_GOLDEN_ALPHANUMERIC TEST_GOLDEN_8BIT, 7, &plan) && QrTinyPlanWrite(buffer, 0, TEST_GOLDEN_NUMERIC TEST_GOLDEN_ALPHANUMERIC TEST_GOLDEN_8BIT, &plan) == plan.bits);
+}
+
+// Reference mask penalty, module by module: runs of five or more (N1), 2x2 blocks (N2), finder-like patterns with four light
+// modules before or after, counting light beyond the edges (N3, each side separately), and the dark proportion (N4)
+static int TestPenalty(const uint8_t *buffer, uint16_t formatInfo)
+{
+    int penalty = 0;
+    int dark = 0;
+    for (int direction = 0; direction < 2; direction++)
+    {
+        for (int i = 0; i < QRTINY_DIMENSION; i++)
+        {
+            int line[QRTINY_DIMENSION + 8] = { 0 };
+            for (int j = 0; j < QRTINY_DIMENSION; j++)
+            {
+                line[4 + j] = direction ? QrTinyModuleGet(buffer, formatInfo, i, j) : QrTinyModuleGet(buffer, formatInfo, j, i);
+                if (!direction) dark += line[4 + j];
+            }
+            int run = 0;
+            for (int j = 0; j < QRTINY_DIMENSION; j++)
+            {
+                run = (j > 0 && line[4 + j] == line[3 + j]) ? run + 1 : 1;
+                if (run == 5) penalty += 3;
+                else if (run > 5) penalty += 1;
+            }
+            static const int finder[7] = { 1, 0, 1, 1, 1, 0, 1 };
+            for (int j = 4; j + 7 <= QRTINY_DIMENSION + 4; j++)
+            {
+                if (memcmp(&line[j], finder, sizeof(finder)) != 0) continue;
+                if (!line[j - 4] && !line[j - 3] && !line[j - 2] && !line[j - 1]) penalty += 40;
+                if (!line[j + 7] && !line[j + 8] && !line[j + 9] && !line[j + 10]) penalty += 40;
+            }
+        }
+    }
+    for (int y = 0; y < QRTINY_DIMENSION - 1; y++)
+    {
+        for (int x = 0; x < QRTINY_DIMENSION - 1; x++)
+        {
+            int sum = QrTinyModuleGet(buffer, formatInfo, x, y) + QrTinyModuleGet(buffer, formatInfo, x + 1, y) + QrTinyModuleGet(buffer, formatInfo, x, y + 1) + QrTinyModuleGet(buffer, formatInfo, x + 1, y + 1);
+            if (sum == 0 || sum == 4) penalty += 3;
+        }
+    }
+    // Dark proportion: 10 for more than 5% and up to 10% away from 50%, 20 for more than 10% and up to 15%, and so on
+    int total = QRTINY_DIMENSION * QRTINY_DIMENSION;
+    for (int step = 2; abs(dark * 100 - total * 50) > (step - 1) * 5 * total; step++) penalty += 10;
+    return penalty;
+}
+
+// The chosen mask is exactly one of the masks for the error-correction level, and one with the lowest reference penalty
+static void TestChooseMask(void)
+{
+    static const char *texts[] = { NULL, "Hello", "0000000", "~~~~~~~" };
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++)
+    {
+        for (int ecl = 0; ecl < 4; ecl++)
+        {
+            uint8_t buffer[QRTINY_BUFFER_SIZE];
+            size_t payloadLength = texts[t] ? QrTinyWrite8Bit(buffer, 0, texts[t]) : TestGoldenPayload(buffer);
+            TEST_CHECK(QrTinyGenerate(buffer, payloadLength, QrTinyFormatInfo(ecl, 0)));
+            uint16_t formatInfo = QrTinyChooseMask(buffer, ecl);
+            int found = 0;
+            int lowest = -1;
+            for (int maskPattern = 0; maskPattern < 8; maskPattern++)
+            {
+                if (formatInfo == QrTinyFormatInfo(ecl, maskPattern)) found++;
+                int penalty = TestPenalty(buffer, QrTinyFormatInfo(ecl, maskPattern));
+                if (lowest < 0 || penalty < lowest) lowest = penalty;
+            }
+            TEST_CHECK(found == 1);
+            TEST_CHECK(TestPenalty(buffer, formatInfo) == lowest);
+        }
+    }
+}
+
+// Batch generation matches generating each buffer alone, for partial and whole groups of buffers
+static void TestGenerateBatch(void)
+{
+    #define TEST_BATCH_MAX 70
+    static uint8_t buffers[TEST_BATCH_MAX][QRTINY_BUFFER_SIZE], expected[TEST_BATCH_MAX][QRTINY_BUFFER_SIZE];
+    uint8_t *pointers[TEST_BATCH_MAX];
+    size_t payloadLengths[TEST_BATCH_MAX];
+    uint32_t seed = 1;
+    for (int ecl = 0; ecl < 4; ecl++)
+    {
+        uint16_t formatInfo = QrTinyFormatInfo(ecl, 0);
+        for (size_t count = 0; count <= TEST_BATCH_MAX; count += (count < 3) ? 1 : 17)
+        {
+            for (size_t n = 0; n < count; n++)
+            {
+                char text[8];
+                for (int i = 0; i < 7; i++) { seed = seed * 1103515245 + 12345; text[i] = (char)(' ' + (seed >> 16) % 95); }
+                payloadLengths[n] = QrTinyWrite8BitN(buffers[n], 0, text, (size_t)(n % 8));
+                pointers[n] = buffers[n];
+                memcpy(expected[n], buffers[n], QRTINY_BUFFER_SIZE);
+                TEST_CHECK(QrTinyGenerate(expected[n], payloadLengths[n], formatInfo));
+            }
+            TEST_CHECK(QrTinyGenerateBatch(pointers, payloadLengths, count, formatInfo));
+            int mismatches = 0;
+            for (size_t n = 0; n < count; n++) mismatches += memcmp(buffers[n], expected[n], QRTINY_BUFFER_SIZE) != 0;
+            TEST_CHECK(mismatches == 0);
+        }
+    }
+
+    // A payload that does not fit fails the batch, leaving every buffer unchanged
+    payloadLengths[1] = QRTINY_TOTAL_CAPACITY;
+    memcpy(expected[0], buffers[0], QRTINY_BUFFER_SIZE);
+    TEST_CHECK(!QrTinyGenerateBatch(pointers, payloadLengths, 2, QRTINY_FORMATINFO_MASK_000_ECC_LOW));
+    TEST_CHECK(memcmp(buffers[0], expected[0], QRTINY_BUFFER_SIZE) == 0);
+}
+
+// The changed regions between symbols cover every changed module, within the number of rectangles allowed
+static void TestDiff(void)
+{
+    uint8_t oldBuffer[QRTINY_BUFFER_SIZE], newBuffer[QRTINY_BUFFER_SIZE];
+    uint16_t formatInfo = QRTINY_FORMATINFO_MASK_010_ECC_LOW;
+    size_t offset = QrTinyWriteAlphanumeric(oldBuffer, 0, "HTTPS://XYZ.DEV/-");
+    memcpy(newBuffer, oldBuffer, sizeof(newBuffer));
+    TEST_CHECK(QrTinyGenerate(oldBuffer, offset + QrTinyWriteNumeric(oldBuffer, offset, "000123"), formatInfo));
+    TEST_CHECK(QrTinyGenerate(newBuffer, offset + QrTinyWriteNumeric(newBuffer, offset, "000124"), formatInfo));
+
+    qrtiny_rect_t rects[QRTINY_DIMENSION];
+    TEST_CHECK(QrTinyDiff(oldBuffer, formatInfo, oldBuffer, formatInfo, rects, 1) == 0);
+    TEST_CHECK(QrTinyDiff(oldBuffer, formatInfo, newBuffer, formatInfo, rects, 0) == -1);
+    static const int maxRects[] = { 1, 2, 4, QRTINY_DIMENSION };
+    for (int change = 0; change < 2; change++)
+    {
+        uint16_t newFormatInfo = change ? QRTINY_FORMATINFO_MASK_101_ECC_LOW : formatInfo;     // Then with a different mask pattern
+        for (size_t m = 0; m < sizeof(maxRects) / sizeof(maxRects[0]); m++)
+        {
+            int count = QrTinyDiff(oldBuffer, formatInfo, newBuffer, newFormatInfo, rects, maxRects[m]);
+            TEST_CHECK(count >= 1 && count <= maxRects[m]);
+            int uncovered = 0, minX = QRTINY_DIMENSION, minY = QRTINY_DIMENSION, maxX = -1, maxY = -1;
+            for (int y = 0; y < QRTINY_DIMENSION; y++)
+            {
+                for (int x = 0; x < QRTINY_DIMENSION; x++)
+                {
+                    if (QrTinyModuleGet(oldBuffer, formatInfo, x, y) == QrTinyModuleGet(newBuffer, newFormatInfo, x, y)) continue;
+                    bool covered = false;
+                    for (int i = 0; i < count; i++)
+                    {
+                        covered |= x >= rects[i].x && x < rects[i].x + rects[i].width && y >= rects[i].y && y < rects[i].y + rects[i].height;
+                    }
+                    uncovered += !covered;
+                    if (x < minX) minX = x;
+                    if (y < minY) minY = y;
+                    if (x > maxX) maxX = x;
+                    if (y > maxY) maxY = y;
+                }
+            }
+            TEST_CHECK(uncovered == 0);
+            if (maxRects[m] == 1) TEST_CHECK(rects[0].x == minX && rects[0].y == minY && rects[0].x + rects[0].width == maxX + 1 && rects[0].y + rects[0].height == maxY + 1);
+        }
+    }
+}
+
+// Pixel at (x, y) of a surface: 0/1 for 1 bpp, otherwise the byte or (native-endian) 16-bit value
+static unsigned int TestBlitPixel(const uint8_t *surface, size_t stride, int pixelFormat, int x, int y)
+{
+    const uint8_t *line = surface + stride * (size_t)y;
+    switch (pixelFormat)
+    {
+        case QRTINY_PIXEL_1BPP_MSB: return (line[x >> 3] >> (7 - (x & 7))) & 1;
+        case QRTINY_PIXEL_1BPP_LSB: return (line[x >> 3] >> (x & 7)) & 1;
+        case QRTINY_PIXEL_8BPP: return line[x];
+        default: { uint16_t value; memcpy(&value, line + 2 * x, 2); return value; }
+    }
+}
+
+// Every pixel of a scaled blit matches its module, in each pixel format, without changing the surface beyond the drawn area
+static void TestBlit(void)
+{
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+    size_t payloadLength = TestGoldenPayload(buffer);
+    uint16_t formatInfo = QRTINY_FORMATINFO_MASK_011_ECC_QUARTILE;
+    TEST_CHECK(QrTinyGenerate(buffer, payloadLength, formatInfo));
+    static const unsigned int dark[4] = { 1, 1, 0x00, 0x0000 }, light[4] = { 0, 0, 0xff, 0xffff };
+    static uint8_t surface[(QRTINY_DIMENSION + 4) * 7 * ((QRTINY_DIMENSION + 4) * 7 + 8) * 2 + 64];
+    static uint8_t background[sizeof(surface)];
+    for (int pixelFormat = QRTINY_PIXEL_1BPP_MSB; pixelFormat <= QRTINY_PIXEL_RGB565; pixelFormat++)
+    {
+        for (int scale = 1; scale <= 7; scale += 3)
+        {
+            int quiet = 2;
+            bool invert = (scale == 4);
+            int size = (QRTINY_DIMENSION + 2 * quiet) * scale;
+            int padding = (pixelFormat <= QRTINY_PIXEL_1BPP_LSB) ? 8 * 3 + 5 : 3;   // Pixels beyond the drawn width, within the stride
+            size_t stride = ((size_t)(size + padding) * (pixelFormat == QRTINY_PIXEL_RGB565 ? 16 : pixelFormat == QRTINY_PIXEL_8BPP ? 8 : 1) + 7) / 8;
+            for (size_t i = 0; i < sizeof(surface); i++) background[i] = (uint8_t)(i * 0x9d + 0x5a);
+            memcpy(surface, background, sizeof(surface));
+            TEST_CHECK(QrTinyBlit(buffer, formatInfo, surface, stride, pixelFormat, scale, quiet, invert));
+            int errors = 0;
+            for (int y = 0; y < (int)(sizeof(surface) / stride); y++)
+            {
+                for (int x = 0; x < size + padding; x++)
+                {
+                    unsigned int expected = TestBlitPixel(background, stride, pixelFormat, x, y);
+                    if (x < size && y < size)
+                    {
+                        bool isDark = QrTinyModuleGet(buffer, formatInfo, x / scale - quiet, y / scale - quiet) != invert;
+                        expected = isDark ? dark[pixelFormat] : light[pixelFormat];
+                    }
+                    if (TestBlitPixel(surface, stride, pixelFormat, x, y) != expected) errors++;
+                }
+            }
+            TEST_CHECK(errors == 0);
+        }
+    }
+    TEST_CHECK(!QrTinyBlit(buffer, formatInfo, surface, 0, QRTINY_PIXEL_8BPP, 0, 0, false));
+    TEST_CHECK(!QrTinyBlit(buffer, formatInfo, surface, 0, QRTINY_PIXEL_RGB565 + 1, 1, 0, false));
+}
+
+// A template updated with a new serial number matches the code generated from scratch
+static void TestTemplate(void)
+{
+    static const char prefix[] = "HTTPS://XYZ.DEV/-";
+    static const char *serials[] = { "000123", "000124", "999999", "000000", "000000", "123456" };
+    for (int ecl = 0; ecl < 4; ecl++)
+    {
+        uint16_t formatInfo = QrTinyFormatInfo(ecl, 3);
+        uint8_t buffer[QRTINY_BUFFER_SIZE];
+        size_t offset = QrTinyWriteAlphanumeric(buffer, 0, ecl == QRTINY_ECL_LOW ? prefix : "X/-");
+        size_t payloadLength = offset + QrTinyWriteNumeric(buffer, offset, "000000");
+        TEST_CHECK(QrTinyGenerate(buffer, payloadLength, formatInfo));
+
+        static qrtiny_template_t tmpl;
+        QrTinyTemplateInit(&tmpl, buffer, formatInfo);
+        for (size_t s = 0; s < sizeof(serials) / sizeof(serials[0]); s++)
+        {
+            size_t bitCount = QrTinyWriteNumeric(tmpl.buffer, offset, serials[s]);
+            QrTinyTemplateUpdate(&tmpl, offset, bitCount);
+
+            uint8_t expected[QRTINY_BUFFER_SIZE];
+            qrtiny_row_t rows[QRTINY_DIMENSION];
+            memcpy(expected, buffer, offset / 8 + 1);
+            payloadLength = offset + QrTinyWriteNumeric(expected, offset, serials[s]);
+            TEST_CHECK(QrTinyGenerate(expected, payloadLength, formatInfo));
+            QrTinyRender(expected, formatInfo, rows);
+            TEST_CHECK(memcmp(tmpl.buffer, expected, sizeof(expected)) == 0);
+            TEST_CHECK(memcmp(tmpl.rows, rows, sizeof(rows)) == 0);
+        }
+    }
+}
+
+// Rendered symbols verify and decode back to the text, correcting codeword errors (in the first block) up to the capacity of each error-correction level
+static void TestVerify(void)
+{
+    static const char *texts[] = { "", "0123ABc", "HELLO", "hello", "ABCDE012345678901", "12345678901234567" };
+    // (ECC codewords - misdecode protection codewords) / 2, for each block
+#if QRTINY_VERSION == 1
+    static const int correctable[4] = { 4, 2, 8, 6 };
+#elif QRTINY_VERSION == 2
+    static const int correctable[4] = { 8, 4, 14, 11 };
+#elif QRTINY_VERSION == 3
+    static const int correctable[4] = { 13, 7, 11, 9 };
+#else
+    static const int correctable[4] = { 9, 10, 8, 13 };
+#endif
+    static const int eccBlockCodewords[4] = { QRTINY_ECC_BLOCK_CODEWORDS }, eccBlocks[4] = { QRTINY_ECC_BLOCKS };
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++)
+    {
+        qrtiny_plan_t plan;
+        size_t length = strlen(texts[t]);
+        TEST_CHECK(QrTinyPlan(texts[t], length, &plan));
+        for (int ecl = 0; ecl < 4; ecl++)
+        {
+            for (int maskPattern = 0; maskPattern < 8; maskPattern++)
+            {
+                uint8_t buffer[QRTINY_BUFFER_SIZE];
+                uint16_t formatInfo = QrTinyFormatInfo(ecl, maskPattern);
+                if (!QrTinyGenerate(buffer, QrTinyPlanWrite(buffer, 0, texts[t], &plan), formatInfo)) continue;
+
+                // Codeword errors, in the data then the error-correction codewords of the first block
+                size_t dataCodewords = QRTINY_TOTAL_CAPACITY / 8 - (size_t)(eccBlockCodewords[ecl] * eccBlocks[ecl]);
+                size_t blockData = dataCodewords / (size_t)eccBlocks[ecl];
+                size_t blockLength = blockData + (size_t)eccBlockCodewords[ecl];
+                for (int errors = 0; errors <= correctable[ecl]; errors++)
+                {
+                    uint8_t damaged[QRTINY_BUFFER_SIZE];
+                    memcpy(damaged, buffer, sizeof(damaged));
+                    for (int e = 0; e < errors; e++)
+                    {
+                        size_t codeword = (t * 7 + (size_t)e * 3 + (size_t)maskPattern) % blockLength;
+                        damaged[codeword < blockData ? codeword : dataCodewords + codeword - blockData] ^= (uint8_t)(0x5a + e * 31 + maskPattern);
+                    }
+                    qrtiny_row_t rows[QRTINY_DIMENSION];
+                    QrTinyRender(damaged, formatInfo, rows);
+                    if (errors == 1 && maskPattern < 3) rows[8] ^= 1 << maskPattern;    // ...and format info bit errors in one copy
+
+                    uint8_t decoded[QRTINY_BUFFER_SIZE];
+                    uint16_t decodedFormatInfo = 0;
+                    char text[64];
+                    TEST_CHECK(QrTinyVerify(rows, decoded, &decodedFormatInfo) == errors);
+                    TEST_CHECK(decodedFormatInfo == formatInfo);
+                    TEST_CHECK(memcmp(decoded, buffer, sizeof(buffer)) == 0);
+                    TEST_CHECK(QrTinyDecode(decoded, decodedFormatInfo, text, sizeof(text)) == (int)length && memcmp(text, texts[t], length + 1) == 0);
+                    TEST_CHECK(QrTinyDecode(decoded, decodedFormatInfo, text, length) == -1);
+                }
+
+                // Damaged finder
+                qrtiny_row_t rows[QRTINY_DIMENSION];
+                uint16_t decodedFormatInfo;
+                QrTinyRender(buffer, formatInfo, rows);
+                rows[3] ^= 1 << 3;
+                TEST_CHECK(QrTinyVerify(rows, buffer, &decodedFormatInfo) == -1);
+            }
+        }
+    }
+}
+
+// Records written to a file read back (memory-mapped) as the same symbols, and can be found by payload
+static void TestRecords(void)
+{
+    static const char *filename = "qrtiny-test.records";
+    static const char *texts[] = { "HELLO", "hello", "0123", "HTTPS://XYZ.DEV/-000123", "" };
+    size_t textCount = sizeof(texts) / sizeof(texts[0]);
+    uint8_t buffers[sizeof(texts) / sizeof(texts[0])][QRTINY_BUFFER_SIZE];
+    uint16_t formatInfos[sizeof(texts) / sizeof(texts[0])];
+
+    FILE *fp = fopen(filename, "w+b");
+    TEST_CHECK(fp != NULL);
+    if (fp == NULL) return;
+    qrtiny_records_writer_t writer;
+    TEST_CHECK(QrTinyRecordsWriterOpen(&writer, fp, true));
+    for (size_t t = 0; t < textCount; t++)
+    {
+        qrtiny_plan_t plan;
+        qrtiny_record_t record;
+        TEST_CHECK(QrTinyPlan(texts[t], strlen(texts[t]), &plan));
+        TEST_CHECK(QrTinyGenerate(buffers[t], QrTinyPlanWrite(buffers[t], 0, texts[t], &plan), QrTinyFormatInfo(plan.ecl, 0)));
+        formatInfos[t] = QrTinyChooseMask(buffers[t], plan.ecl);
+        QrTinyRecordMake(&record, buffers[t], formatInfos[t], texts[t], strlen(texts[t]));
+        TEST_CHECK(QrTinyRecordsWriterAppend(&writer, &record, 1));
+    }
+    TEST_CHECK(QrTinyRecordsWriterClose(&writer));
+    fclose(fp);
+
+    qrtiny_records_t records;
+    TEST_CHECK(QrTinyRecordsOpen(&records, filename));
+    TEST_CHECK(records.count == textCount && records.index != NULL);
+    for (size_t t = 0; t < textCount; t++)
+    {
+        const qrtiny_record_t *record = QrTinyRecordsGet(&records, t);
+        TEST_CHECK(record != NULL && memcmp(record->buffer, buffers[t], QRTINY_BUFFER_SIZE) == 0 && QrTinyRecordFormatInfo(record) == formatInfos[t]);
+        TEST_CHECK(record != NULL && QrTinyModuleGet(record->buffer, QrTinyRecordFormatInfo(record), 10, 10) == QrTinyModuleGet(buffers[t], formatInfos[t], 10, 10));
+        TEST_CHECK(QrTinyRecordsFind(&records, texts[t], strlen(texts[t])) == (int64_t)t);
+    }
+    TEST_CHECK(QrTinyRecordsGet(&records, textCount) == NULL);
+    TEST_CHECK(QrTinyRecordsFind(&records, "HELLO!", 6) == -1);
+    QrTinyRecordsClose(&records);
+    remove(filename);
+}
+
+#ifdef QRTINY_STATS
+// Each phase of generating one code is counted once
+static void TestStats(void)
+{
+    QrTinyStatsReset();
+    qrtiny_plan_t plan;
+    uint8_t buffer[QRTINY_BUFFER_SIZE];
+    qrtiny_row_t rows[QRTINY_DIMENSION];
+    TEST_CHECK(QrTinyPlan("HELLO", 5, &plan));
+    TEST_CHECK(QrTinyGenerate(buffer, QrTinyPlanWrite(buffer, 0, "HELLO", &plan), QrTinyFormatInfo(plan.ecl, 0)));
+    QrTinyRender(buffer, QrTinyFormatInfo(plan.ecl, 0), rows);
+
+    qrtiny_stats_t stats;
+    QrTinyStatsGet(&stats);
+    for (int phase = 0; phase < QRTINY_STATS_PHASES; phase++)
+    {
+        const qrtiny_stats_phase_t *p = &stats.phases[phase];
+        uint64_t histogramCalls = 0;
+        for (int bucket = 0; bucket < QRTINY_STATS_BUCKETS; bucket++) histogramCalls += p->histogram[bucket];
+        TEST_CHECK(QrTinyStatsPhaseName(phase) != NULL);
+        TEST_CHECK(p->calls == (phase <= QRTINY_STATS_RENDER ? 1 : 0));
+        TEST_CHECK(histogramCalls == p->calls && p->max <= p->total);
+    }
+
+    qrtiny_stats_t total = stats;
+    QrTinyStatsAdd(&total, &stats);
+    TEST_CHECK(total.phases[QRTINY_STATS_ECC].calls == 2 && total.phases[QRTINY_STATS_ECC].total == 2 * stats.phases[QRTINY_STATS_ECC].total);
+    QrTinyStatsReset();
+    QrTinyStatsGet(&stats);
+    TEST_CHECK(stats.phases[QRTINY_STATS_ECC].calls == 0);
+}
+#endif
+
+int main(void)
+{
+    TestGolden();
+    TestRowGet();
+    TestWriters();
+    TestPlan();
+    TestGenerateBatch();
+    TestChooseMask();
+    TestBlit();
+    TestDiff();
+    TestTemplate();
+    TestVerify();
+    TestRecords();
+#ifdef QRTINY_STATS
+    TestStats();
+#endif
+    printf("%s: %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
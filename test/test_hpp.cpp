@@ -0,0 +1,80 @@
+// QR Code V1-V4 Generator - Tests for the compile-time C++ front-end
+// Dan Jackson, 2020
+
+#include <cstdio>
+#include <cstring>
+
+#include "qrtiny.hpp"
+
+static int failures = 0;
+#define TEST_CHECK(_condition) do { if (!(_condition)) { fprintf(stderr, "FAIL: %s:%d: %s\n", __FILE__, __LINE__, #_condition); failures++; } } while (0)
+
+// Generated at compile time
+static constexpr qrtiny::Symbol testSymbol = qrtiny::make("HTTPS://X.DEV/ABC");
+static constexpr qrtiny::Symbol testSymbolFixed = qrtiny::make("0123ABc", qrtiny::Ecc::Quartile, qrtiny::Mask::M101);
+static_assert(testSymbol.formatInfo != 0, "compile-time generation");
+static_assert(testSymbolFixed.formatInfo == QRTINY_FORMATINFO_MASK_101_ECC_QUARTILE, "requested format");
+static_assert(testSymbolFixed.module(0, 0) == 1 && testSymbolFixed.module(7, 7) == 0, "finder pattern");
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+static_assert(qrtiny::make<"0123ABc", qrtiny::Ecc::Quartile, qrtiny::Mask::M101>().rows == testSymbolFixed.rows, "template form");
+#endif
+
+// The C path: plan, write, generate, choose the mask (or use the one given), render
+static bool TestReference(const char *text, int ecl, int maskPattern, qrtiny_row_t rows[QRTINY_DIMENSION], uint16_t *formatInfo)
+{
+    qrtiny_plan_t plan;
+    if (!QrTinyPlan(text, strlen(text), &plan)) return false;
+    if (ecl < 0) ecl = plan.ecl;
+    uint8_t buffer[QRTINY_BUFFER_SIZE] = { 0 };
+    size_t payloadLength = QrTinyPlanWrite(buffer, 0, text, &plan);
+    if (!QrTinyGenerate(buffer, payloadLength, QrTinyFormatInfo(ecl, 0))) return false;
+    *formatInfo = maskPattern < 0 ? QrTinyChooseMask(buffer, ecl) : QrTinyFormatInfo(ecl, maskPattern);
+    QrTinyRender(buffer, *formatInfo, rows);
+    return true;
+}
+
+static bool TestMatches(const qrtiny::Symbol &symbol, const char *text, int ecl, int maskPattern)
+{
+    qrtiny_row_t rows[QRTINY_DIMENSION];
+    uint16_t formatInfo;
+    if (!TestReference(text, ecl, maskPattern, rows, &formatInfo)) return false;
+    return symbol.formatInfo == formatInfo && memcmp(symbol.rows.data(), rows, sizeof(rows)) == 0;
+}
+
+static void TestCompileTime(void)
+{
+    TEST_CHECK(TestMatches(testSymbol, "HTTPS://X.DEV/ABC", -1, -1));
+    TEST_CHECK(TestMatches(testSymbolFixed, "0123ABc", QRTINY_ECL_QUARTILE, 5));
+}
+
+// The same code, evaluated at run time, for a range of payloads at each error-correction level and mask pattern
+static void TestConsistency(void)
+{
+    static const char *const texts[] = {
+        "", "0", "0123", "ABCDE012345678901", "Hello, world!", "HTTPS://X/", "12345678901234567",
+        "abcdefghijklmno", "A1B2C3D4E5", "01234567890123456789012345678901234567890",
+    };
+    for (const char *text : texts)
+    {
+        qrtiny_plan_t plan;
+        TEST_CHECK(QrTinyPlan(text, strlen(text), &plan));
+        TEST_CHECK(TestMatches(qrtiny::make(text), text, -1, -1));
+        for (int ecl = 0; ecl < 4; ecl++)
+        {
+            if (plan.bits > qrtiny::detail::data_codewords(ecl) * 8) continue;
+            TEST_CHECK(TestMatches(qrtiny::make(text, (qrtiny::Ecc)ecl), text, ecl, -1));
+            for (int maskPattern = 0; maskPattern < 8; maskPattern++)
+            {
+                TEST_CHECK(TestMatches(qrtiny::make(text, (qrtiny::Ecc)ecl, (qrtiny::Mask)maskPattern), text, ecl, maskPattern));
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    TestCompileTime();
+    TestConsistency();
+    printf("%s: %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}